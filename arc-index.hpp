@@ -0,0 +1,38 @@
+/*
+  Índice dos arcos de uma rede agrupados por um dos extremos: pela origem
+  (CSR, arcos que saem de cada nó) ou pelo destino (CSC, arcos que chegam).
+  Usado para montar as restrições de conservação dos modelos do CPLEX a
+  partir da lista de arcos, em tempo e memória proporcionais ao número de
+  arcos em vez de n².
+*/
+
+#ifndef ARC_INDEX_HPP
+#define ARC_INDEX_HPP
+
+#include <vector>
+#include <cstddef>
+
+class ArcIndex {
+public:
+    // endpoint(k) é o nó, entre 0 e nodes - 1, pelo qual o arco k é agrupado
+    template <class Endpoint>
+    ArcIndex(int nodes, size_t arcs, Endpoint endpoint) : first_(nodes + 1, 0), arcs_(arcs) {
+        for (size_t k = 0; k < arcs; ++k)
+            ++first_[endpoint(k) + 1];
+        for (int v = 0; v < nodes; ++v)
+            first_[v + 1] += first_[v];
+        std::vector<size_t> next(first_.begin(), first_.end() - 1);
+        for (size_t k = 0; k < arcs; ++k)
+            arcs_[next[endpoint(k)]++] = k;
+    }
+
+    // Arcos do nó v, em ordem crescente de índice
+    const size_t* begin(int v) const { return arcs_.data() + first_[v]; }
+    const size_t* end(int v) const { return arcs_.data() + first_[v + 1]; }
+
+private:
+    std::vector<size_t> first_;
+    std::vector<size_t> arcs_;
+};
+
+#endif
@@ -0,0 +1,187 @@
+/*
+  Benchmark da busca local de Bin Packing. Gera instâncias das famílias
+  clássicas a partir de uma semente, resolve cada uma com semente e tempo
+  fixos e imprime uma linha CSV por instância, para comparar versões:
+
+    uniforme   Falkenauer u: capacidade 150, itens uniformes em [20, 100]
+    tripletos  Falkenauer t: capacidade 1000, trincas que somam exatamente
+               1000 (ótimo conhecido: n / 3 bins)
+    scholl     Scholl conjunto 1: capacidade 100, 120 ou 150, itens
+               uniformes em [1, 100], [20, 100] ou [30, 100]
+    assimetrica muitos itens pequenos e poucos grandes: capacidade 1000,
+               itens 1000 * u^3 com u uniforme em (0, 1]
+
+  Colunas: familia, n, capacidade, instancia, limitante, otimo (vazio se
+  desconhecido), heuristica, bins_heuristica, bins, gap (contra o ótimo ou o
+  limitante), avaliacoes, avaliacoes_por_s, tempo_melhor_s,
+  tempo_limitante_s (vazio se não chegou ao limitante) e terminou.
+
+  Com --escala 1,2,4,8 cada instância é resolvida uma vez por número de
+  threads da lista, e a saída passa a ser a trajetória da incumbente, para
+  ver como o número de bins ao longo do tempo muda com as threads. Colunas:
+  familia, n, instancia, limitante, threads, tempo_s e bins, uma linha por
+  melhora.
+
+  Uso: bench-bin-packing [--tempo s] [--threads N] [--semente S]
+                         [--instancias K] [--familia nome] [--salvar dir]
+                         [--motor permutacao|bins] [--escala N,N,...]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <string>
+#include <sstream>
+#include <cmath>
+#include <cstdint>
+
+#include "bin-packing.hpp"
+#include "bin-packing-io.hpp"
+
+struct Generated {
+    std::string family;
+    Instance<int64_t> instance;
+    int64_t optimum;  // 0 se desconhecido
+};
+
+std::vector<int64_t> uniform_items(std::mt19937_64& gen, size_t n, int64_t lo, int64_t hi) {
+    std::uniform_int_distribution<int64_t> dist(lo, hi);
+    std::vector<int64_t> items(n);
+    for (int64_t& item : items)
+        item = dist(gen);
+    return items;
+}
+
+Generated falkenauer_uniform(std::mt19937_64& gen, size_t n) {
+    return {"uniforme", {150, uniform_items(gen, n, 20, 100)}, 0};
+}
+
+// Cada trinca tem um item em [380, 490] e dois em [250, 500) completando 1000
+Generated falkenauer_triplets(std::mt19937_64& gen, size_t n) {
+    n -= n % 3;
+    std::vector<int64_t> items;
+    for (size_t t = 0; t < n / 3; ++t) {
+        int64_t first = std::uniform_int_distribution<int64_t>(380, 490)(gen);
+        int64_t second = std::uniform_int_distribution<int64_t>(250, 1000 - first - 250)(gen);
+        items.insert(items.end(), {first, second, 1000 - first - second});
+    }
+    std::shuffle(items.begin(), items.end(), gen);
+    return {"tripletos", {1000, items}, int64_t(n / 3)};
+}
+
+Generated scholl(std::mt19937_64& gen, size_t n, int variant) {
+    const int64_t capacities[] = {100, 120, 150};
+    const int64_t minimums[] = {1, 20, 30};
+    int64_t capacity = capacities[variant % 3], lo = minimums[variant / 3 % 3];  // 9 combinações
+    return {"scholl", {capacity, uniform_items(gen, n, lo, 100)}, 0};
+}
+
+Generated skewed(std::mt19937_64& gen, size_t n) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<int64_t> items(n);
+    for (int64_t& item : items)
+        item = std::max<int64_t>(1, std::llround(1000 * std::pow(1.0 - dist(gen), 3)));
+    return {"assimetrica", {1000, items}, 0};
+}
+
+int main(int argc, char* argv[]) {
+    SearchOptions options;
+    options.time_limit = 1;
+    uint64_t seed = 1;
+    int per_size = 1;
+    std::string only, save;
+    std::vector<int> scaling;
+    for (int i = 1; i + 1 < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--tempo")
+            options.time_limit = std::stoi(argv[++i]);
+        else if (arg == "--threads")
+            options.threads = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--semente")
+            seed = std::stoull(argv[++i]);
+        else if (arg == "--instancias")
+            per_size = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--familia")
+            only = argv[++i];
+        else if (arg == "--salvar")
+            save = argv[++i];
+        else if (arg == "--motor")
+            options.annealing = std::string(argv[++i]) == "bins";
+        else if (arg == "--escala")
+            for (std::stringstream list(argv[++i]); std::getline(list, arg, ',');)
+                scaling.push_back(std::max(1, std::stoi(arg)));
+    }
+
+    // Mesma semente, mesmas instâncias: a sequência de geração não depende
+    // de --familia nem do tempo
+    std::mt19937_64 gen(seed);
+    std::vector<Generated> instances;
+    for (size_t n : {120, 250, 500, 1000})
+        for (int k = 0; k < per_size; ++k)
+            instances.push_back(falkenauer_uniform(gen, n));
+    for (size_t n : {60, 120, 249, 501})
+        for (int k = 0; k < per_size; ++k)
+            instances.push_back(falkenauer_triplets(gen, n));
+    int variant = 0;
+    for (size_t n : {50, 100, 200, 500})
+        for (int k = 0; k < per_size; ++k)
+            instances.push_back(scholl(gen, n, variant++ * 4));
+    for (size_t n : {500, 2000, 10000})
+        for (int k = 0; k < per_size; ++k)
+            instances.push_back(skewed(gen, n));
+
+    if (!scaling.empty()) {
+        std::cout << "familia,n,instancia,limitante,threads,tempo_s,bins" << std::endl;
+        for (size_t id = 0; id < instances.size(); ++id) {
+            const Generated& g = instances[id];
+            if (!only.empty() && g.family != only)
+                continue;
+
+            // Mesma semente para todas as contagens: o worker 0 parte sempre
+            // da mesma solução
+            for (int threads : scaling) {
+                options.threads = threads;
+                options.seed = seed + id;
+                SearchResult<int64_t> result = solve(g.instance.items, g.instance.capacity, options);
+                for (const auto& [seconds, bins] : result.trace)
+                    std::cout << g.family << ',' << g.instance.items.size() << ',' << id << ','
+                              << result.bounds.best() << ',' << threads << ',' << std::fixed
+                              << std::setprecision(6) << seconds << ',' << bins << std::endl;
+            }
+        }
+        return 0;
+    }
+
+    std::cout << "familia,n,capacidade,instancia,limitante,otimo,heuristica,bins_heuristica,bins,gap,"
+                 "avaliacoes,avaliacoes_por_s,tempo_melhor_s,tempo_limitante_s,terminou" << std::endl;
+
+    for (size_t id = 0; id < instances.size(); ++id) {
+        const Generated& g = instances[id];
+        if (!only.empty() && g.family != only)
+            continue;
+
+        const auto& instance = g.instance;
+        if (!save.empty())
+            write_text(save + "/" + g.family + "-" + std::to_string(id) + ".dat", instance, 1);
+
+        options.seed = seed + id;
+        SearchResult<int64_t> result = solve(instance.items, instance.capacity, options);
+
+        int64_t bins = result.packing.bins();
+        int64_t bound = result.bounds.best();
+        int64_t reference = g.optimum ? g.optimum : bound;
+        bool at_bound = bins <= bound;
+
+        std::cout << g.family << ',' << instance.items.size() << ',' << instance.capacity << ',' << id << ','
+                  << bound << ',' << (g.optimum ? std::to_string(g.optimum) : "") << ','
+                  << result.heuristic << ',' << result.heuristic_bins << ',' << bins << ','
+                  << bins - reference << ',' << result.evaluations << ','
+                  << std::fixed << std::setprecision(0) << result.evaluations / std::max(result.seconds, 1e-9) << ','
+                  << std::setprecision(6) << result.best_seconds << ',';
+        if (at_bound)
+            std::cout << result.best_seconds;
+        std::cout << ',' << result.finished << std::endl;
+    }
+    return 0;
+}
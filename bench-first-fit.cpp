@@ -0,0 +1,119 @@
+/*
+  Micro-benchmark do First Fit: compara a árvore de segmentos (FirstFitTree)
+  com a varredura linear (FirstFitScan) em versão escalar, AVX2 e AVX-512,
+  para instâncias com número crescente de bins. A última linha estima, para
+  cada nível, até quantas bins a varredura ganha, interpolando entre as duas
+  medições em que a ordem se inverte; são os valores de scan_max_bins() em
+  bin-packing.hpp.
+
+  Uso: bench-first-fit [repeticoes]
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <string>
+#include <cmath>
+
+#include "bin-packing.hpp"
+
+// Empacota a permutação com a estrutura Index e retorna o número de bins
+template <typename Index>
+size_t pack(Index& index, const std::vector<int32_t>& items, int32_t capacity) {
+    index.reset(items.size());
+    size_t open = 0;
+    for (int32_t item : items) {
+        size_t bin = index.first_fit(item, capacity);
+        if (bin >= open)
+            bin = open++;
+        index.add(bin, item);
+    }
+    return open;
+}
+
+// Tempo médio por item, em nanossegundos
+template <typename Index>
+double time_per_item(const std::vector<int32_t>& items, int32_t capacity, int repetitions) {
+    Index index;
+    size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r)
+        checksum += pack(index, items, capacity);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    // Barreira vazia que consome o resultado, para o empacotamento não ser
+    // descartado pelo otimizador
+    asm volatile("" : : "r"(checksum) : "memory");
+    return elapsed.count() / (double(repetitions) * items.size());
+}
+
+int main(int argc, char* argv[]) {
+    int repetitions = argc > 1 ? std::stoi(argv[1]) : 20;
+    const int32_t capacity = 1000;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int32_t> size(200, 600);
+
+    std::cout << std::setw(8) << "itens" << std::setw(8) << "bins"
+              << std::setw(10) << "arvore" << std::setw(10) << "escalar"
+              << std::setw(10) << "avx2" << std::setw(10) << "avx512" << "   (ns/item)\n";
+
+    // Cruzamento de cada nível: bins e vantagem relativa da varredura na
+    // última medição em que ela ainda ganhava; 0 bins se nunca ganhou
+    const SimdLevel levels[] = {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512};
+    double crossing[3] = {0, 0, 0}, last_bins[3] = {0, 0, 0}, last_ratio[3] = {0, 0, 0};
+    bool crossed[3] = {false, false, false};
+
+    SimdLevel available = detect_simd_level();
+    for (size_t n = 64; n <= (1 << 16); n = n % 3 ? n / 2 * 3 : n / 3 * 4) {
+        std::vector<int32_t> items(n);
+        for (int32_t& item : items)
+            item = size(gen);
+
+        FirstFitTree<int32_t> tree;
+        size_t bins = pack(tree, items, capacity);
+        int reps = std::max<int>(1, repetitions * 4096 / n);
+
+        double tree_time = time_per_item<FirstFitTree<int32_t>>(items, capacity, reps);
+        std::cout << std::setw(8) << n << std::setw(8) << bins << std::fixed << std::setprecision(1)
+                  << std::setw(10) << tree_time;
+
+        for (int l = 0; l < 3; ++l) {
+            if (levels[l] > available) {
+                std::cout << std::setw(10) << "-";
+                continue;
+            }
+            simd_level = levels[l];
+            double scan_time = time_per_item<FirstFitScan<int32_t>>(items, capacity, reps);
+            std::cout << std::setw(10) << scan_time;
+
+            // log(scan / tree) cresce com as bins: interpola o zero em log(bins)
+            double ratio = std::log(scan_time / tree_time);
+            if (!crossed[l] && ratio >= 0) {
+                crossed[l] = true;
+                if (last_bins[l] > 0) {
+                    double from = std::log(last_bins[l]), to = std::log(double(bins));
+                    crossing[l] = std::exp(from + (to - from) * last_ratio[l] / (last_ratio[l] - ratio));
+                }
+            }
+            last_bins[l] = bins;
+            last_ratio[l] = ratio;
+        }
+        simd_level = available;
+        std::cout << '\n';
+    }
+
+    std::cout << std::setw(8) << "cruzam." << std::setw(8) << "" << std::setw(10) << "";
+    for (int l = 0; l < 3; ++l) {
+        if (levels[l] > available)
+            std::cout << std::setw(10) << "-";
+        else if (!crossed[l])
+            std::cout << std::setw(10) << (">" + std::to_string(int(last_bins[l])));
+        else
+            std::cout << std::setw(10) << int(crossing[l]);
+    }
+    std::cout << "   (bins)\n";
+
+    return 0;
+}
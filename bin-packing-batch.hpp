@@ -0,0 +1,160 @@
+/*
+  Modo lote de Bin Packing (--lote): resolve muitas instâncias pequenas num
+  só processo, em vez de um processo por instância. As instâncias vêm de um
+  diretório (um arquivo por instância, em ordem de nome) ou de uma entrada
+  com várias instâncias concatenadas. Cada uma é resolvida inteira por uma
+  thread do pool, com um único worker e o orçamento de tempo por instância,
+  parando antes ao atingir o limitante inferior. Os resultados saem na ordem
+  da entrada, à medida que ficam prontos.
+*/
+
+#ifndef BIN_PACKING_BATCH_HPP
+#define BIN_PACKING_BATCH_HPP
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+#include "bin-packing-io.hpp"
+
+// Pool com roubo de trabalho para as tarefas 0..count-1. Os índices são
+// distribuídos em rodízio entre as filas das threads, e cada thread consome a
+// sua pela frente, de modo que os primeiros índices terminam primeiro e a
+// saída ordenada anda junto. Uma thread sem trabalho rouba do fim da fila
+// mais cheia, o que equilibra instâncias de durações diferentes
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int threads) : queues_(std::max(1, threads)) {}
+
+    void run(size_t count, const std::function<void(size_t)>& task) {
+        size_t threads = queues_.size();
+        for (size_t i = 0; i < count; ++i)
+            queues_[i % threads].tasks.push_back(i);
+
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t)
+            workers.emplace_back([this, t, &task]() {
+                size_t i;
+                while (pop(t, i) || steal(t, i))
+                    task(i);
+            });
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    std::vector<Queue> queues_;
+
+    bool pop(size_t t, size_t& i) {
+        std::lock_guard<std::mutex> lock(queues_[t].mutex);
+        if (queues_[t].tasks.empty())
+            return false;
+        i = queues_[t].tasks.front();
+        queues_[t].tasks.pop_front();
+        return true;
+    }
+
+    // Nenhuma tarefa é criada depois do início, então filas vazias em todas
+    // as vítimas significam que o lote acabou
+    bool steal(size_t t, size_t& i) {
+        while (true) {
+            size_t victim = t, most = 0;
+            for (size_t v = 0; v < queues_.size(); ++v) {
+                if (v == t)
+                    continue;
+                std::lock_guard<std::mutex> lock(queues_[v].mutex);
+                if (queues_[v].tasks.size() > most) {
+                    most = queues_[v].tasks.size();
+                    victim = v;
+                }
+            }
+            if (victim == t)
+                return false;
+
+            std::lock_guard<std::mutex> lock(queues_[victim].mutex);
+            if (!queues_[victim].tasks.empty()) {
+                i = queues_[victim].tasks.back();
+                queues_[victim].tasks.pop_back();
+                return true;
+            }
+        }
+    }
+};
+
+// Uma instância do lote: o arquivo, carregado pela própria thread que a
+// resolve, ou a instância já lida de uma entrada concatenada
+struct BatchJob {
+    std::string name;
+    std::string path;
+    Instance<int64_t> instance;
+};
+
+// Um diretório vira um job por arquivo comum, em ordem de nome; qualquer
+// outro caminho ("-" é a entrada padrão) é lido como instâncias concatenadas,
+// nomeadas pela posição a partir de 1
+inline std::vector<BatchJob> batch_jobs(const std::string& path) {
+    std::vector<BatchJob> jobs;
+    if (path != "-" && std::filesystem::is_directory(path)) {
+        for (const auto& entry : std::filesystem::directory_iterator(path))
+            if (entry.is_regular_file())
+                jobs.push_back({entry.path().filename().string(), entry.path().string(), {}});
+        std::sort(jobs.begin(), jobs.end(), [](const BatchJob& a, const BatchJob& b) { return a.name < b.name; });
+        return jobs;
+    }
+
+    InputBuffer input(path);
+    InstanceSequence sequence(input);
+    Instance<int64_t> instance;
+    while (sequence.next(instance))
+        jobs.push_back({std::to_string(jobs.size() + 1), "", std::move(instance)});
+    return jobs;
+}
+
+// Resolve os jobs no pool; solve_job devolve o texto de saída de um job, que
+// é entregue a emit na ordem dos jobs assim que todos os anteriores saírem.
+// Os textos já emitidos são liberados, então a memória retida é só a das
+// instâncias resolvidas fora de ordem
+inline void run_batch(std::vector<BatchJob>& jobs, int threads,
+                      const std::function<std::string(BatchJob&)>& solve_job,
+                      const std::function<void(const std::string&)>& emit) {
+    std::vector<std::string> outputs(jobs.size());
+    std::vector<char> ready(jobs.size(), 0);
+    std::mutex mutex;
+    std::condition_variable done;
+
+    std::thread pool([&]() {
+        WorkStealingPool(threads).run(jobs.size(), [&](size_t i) {
+            std::string output = solve_job(jobs[i]);
+            jobs[i].instance = {};
+            std::lock_guard<std::mutex> lock(mutex);
+            outputs[i] = std::move(output);
+            ready[i] = 1;
+            done.notify_one();
+        });
+    });
+
+    for (size_t next = 0; next < jobs.size(); ++next) {
+        std::string output;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [&]() { return ready[next] != 0; });
+            output.swap(outputs[next]);
+        }
+        emit(output);
+    }
+    pool.join();
+}
+
+#endif
@@ -0,0 +1,47 @@
+/*
+  Conversor entre o formato texto (.dat) e o formato binário das instâncias
+  de Bin Packing (ver bin-packing-io.hpp). O sentido da conversão é decidido
+  pelo conteúdo da entrada; --fixo indica uma instância do bin-packing-new
+  (tamanhos fracionários, guardados em ponto fixo com escala 10^6).
+
+  Uso: bin-packing-convert [--fixo] <entrada> <saida>   ("-" = stdin/stdout)
+*/
+
+#include <iostream>
+#include <string>
+
+#include "bin-packing-io.hpp"
+
+// Mesma escala de FIXED_SCALE em bin-packing-new.cpp
+const int32_t FIXED_SCALE = 1000000;
+
+int main(int argc, char* argv[]) {
+    bool fixed = argc > 1 && std::string(argv[1]) == "--fixo";
+    if (argc != 3 + fixed) {
+        std::cerr << "Uso: " << argv[0] << " [--fixo] <entrada> <saida>" << std::endl;
+        return 1;
+    }
+
+    std::string input = argv[1 + fixed], output = argv[2 + fixed];
+    try {
+        InputBuffer buffer(input);
+        bool binary = buffer.is_binary();
+        if (fixed) {
+            Instance<int32_t> instance = load_fixed_instance(buffer, FIXED_SCALE);
+            if (binary)
+                write_text(output, instance, FIXED_SCALE);
+            else
+                write_binary(output, instance, ItemType::Fixed32, FIXED_SCALE);
+        } else {
+            Instance<int64_t> instance = load_integer_instance(buffer);
+            if (binary)
+                write_text(output, instance, 1);
+            else
+                write_binary(output, instance, ItemType::Int64, 1);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,311 @@
+/*
+  Modo exato de Bin Packing (--exato), para instâncias de até algumas
+  centenas de itens. A redução de Martello e Toth fixa as bins que alguma
+  solução ótima certamente contém; o restante é resolvido por bin completion
+  (branch-and-bound por bins, com dominância) partindo da melhor heurística
+  como incumbente, até provar a otimalidade ou atingir o tempo limite,
+  quando devolve a melhor solução e o gap.
+*/
+
+#ifndef BIN_PACKING_EXACT_HPP
+#define BIN_PACKING_EXACT_HPP
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+
+#include "bin-packing.hpp"
+
+// Redução de Martello e Toth com conjuntos de até dois itens. Para o item i
+// com folga r = C - w_i, a bin {i} (se nada cabe junto) ou {i, k}, com k o
+// maior item que cabe, domina qualquer outra bin com i quando nenhum par cabe
+// na folga ou quando w_k == r. Recebe os itens em ordem decrescente e devolve
+// as bins fixadas como listas de índices; removed marca os itens usados
+template <typename Size>
+std::vector<std::vector<size_t>> mt_reduction(const std::vector<Size>& items, Size capacity,
+                                              std::vector<bool>& removed) {
+    size_t n = items.size();
+    removed.assign(n, false);
+    std::vector<std::vector<size_t>> fixed;
+
+    // Índices dos itens ainda livres, em ordem decrescente de tamanho
+    std::vector<size_t> alive(n);
+    for (size_t i = 0; i < n; ++i)
+        alive[i] = i;
+    auto take = [&](size_t i) {
+        removed[i] = true;
+        alive.erase(std::lower_bound(alive.begin(), alive.end(), i));
+    };
+
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t p = 0; p < alive.size();) {
+            size_t i = alive[p];
+            Size r = capacity - items[i];
+
+            // Maior item livre (exceto i) que cabe com i, por busca binária
+            auto fits = std::lower_bound(alive.begin(), alive.end(), r,
+                                         [&](size_t j, Size value) { return items[j] > value; });
+            if (fits != alive.end() && *fits == i)
+                ++fits;
+            size_t k = fits == alive.end() ? n : *fits;
+
+            // Os dois menores itens livres além de i
+            size_t s1 = n, s2 = n;
+            for (size_t q = alive.size(); q-- > 0 && s2 == n;) {
+                if (alive[q] == i)
+                    continue;
+                (s1 == n ? s1 : s2) = alive[q];
+            }
+
+            if (k == n) {
+                fixed.push_back({i});
+            } else if (s2 == n || items[s1] + items[s2] > r || items[k] == r) {
+                fixed.push_back({i, k});
+                take(k);
+            } else {
+                ++p;
+                continue;
+            }
+            take(i);
+            p = std::lower_bound(alive.begin(), alive.end(), i) - alive.begin();
+            changed = true;
+        }
+    }
+    return fixed;
+}
+
+// Bin completion de Korf: cada nível fecha uma bin com o maior item restante
+// e uma das suas completações, os conjuntos de itens restantes que cabem na
+// folga. Os itens ficam agrupados por tamanho, de modo que cada completação é
+// gerada uma única vez como quantidades por tamanho. Só são tentadas as
+// completações não dominadas, das mais cheias para as mais vazias:
+//   - maximais: nenhum item de fora ainda cabe na folga;
+//   - sem troca vantajosa: nenhum item da completação pode ser trocado por um
+//     item maior de fora que ainda caiba.
+// O corte usa max(L1, itens maiores que C / 2) sobre o que resta
+template <typename Size>
+class BinCompletion {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    BinCompletion(const std::vector<Size>& items, Size capacity, size_t incumbent, int64_t lower_bound,
+                  Clock::time_point deadline)
+        : capacity_(capacity), best_(incumbent), lower_bound_(lower_bound), deadline_(deadline) {
+        ItemClasses<Size> classes(items);
+        sizes_ = classes.sizes;
+        left_ = classes.counts;
+        take_.assign(sizes_.size(), 0);
+        for (Size item : items)
+            remaining_ += item;
+        items_left_ = items.size();
+    }
+
+    // Retorna true se a busca terminou, provando a otimalidade de best()
+    bool run() {
+        search();
+        return !timeout_;
+    }
+
+    size_t best() const { return best_; }
+    bool improved() const { return improved_; }
+    const std::vector<std::vector<Size>>& best_bins() const { return best_bins_; }
+    uint64_t nodes() const { return nodes_; }
+
+private:
+    struct Completion {
+        int64_t sum;
+        size_t begin, end;  // Trecho de picks_ com os pares (tamanho, quantidade)
+    };
+
+    Size capacity_;
+    size_t best_;
+    int64_t lower_bound_;
+    Clock::time_point deadline_;
+
+    std::vector<Size> sizes_;     // Tamanhos distintos, em ordem decrescente
+    std::vector<uint32_t> left_;  // Quantos itens de cada tamanho restam
+    std::vector<uint32_t> take_;  // Completação sendo gerada
+    int64_t remaining_ = 0;
+    size_t items_left_ = 0;
+
+    std::vector<std::vector<Size>> bins_, best_bins_;
+    std::vector<std::pair<uint32_t, uint32_t>> picks_;  // Pilha de todas as profundidades
+    std::vector<Completion> completions_;
+    uint64_t nodes_ = 0;
+    bool improved_ = false, timeout_ = false;
+
+    bool done() const { return timeout_ || int64_t(best_) <= lower_bound_; }
+
+    bool tick() {
+        if (++nodes_ % 1024 == 0 && Clock::now() >= deadline_)
+            timeout_ = true;
+        return !timeout_;
+    }
+
+    int64_t bound() const {
+        int64_t large = 0;
+        for (size_t c = 0; c < sizes_.size() && 2 * sizes_[c] > capacity_; ++c)
+            large += left_[c];
+        return bins_.size() + std::max<int64_t>((remaining_ + capacity_ - 1) / capacity_, large);
+    }
+
+    // Gera as completações não dominadas para a folga slack, escolhendo
+    // quantos itens de cada tamanho a partir de c
+    void enumerate(size_t c, Size slack, int64_t sum) {
+        if (!tick())
+            return;
+
+        if (c == sizes_.size()) {
+            // Menor tamanho disponível fora da completação
+            for (size_t z = sizes_.size(); z-- > 0;) {
+                if (left_[z] > take_[z]) {
+                    if (sizes_[z] <= slack)
+                        return;
+                    break;
+                }
+            }
+            // Troca de um item y por um z maior de fora que caiba
+            for (size_t y = 0; y < sizes_.size(); ++y) {
+                if (take_[y] == 0)
+                    continue;
+                for (size_t z = y; z-- > 0;) {
+                    if (left_[z] > take_[z] && sizes_[z] <= slack + sizes_[y])
+                        return;
+                }
+            }
+
+            size_t begin = picks_.size();
+            for (size_t y = 0; y < sizes_.size(); ++y)
+                if (take_[y] > 0)
+                    picks_.push_back({uint32_t(y), take_[y]});
+            completions_.push_back({sum, begin, picks_.size()});
+            return;
+        }
+
+        // Itens de tamanho zero cabem sempre, e todos vão na completação
+        uint32_t most = sizes_[c] == 0 ? left_[c] : uint32_t(std::min<int64_t>(left_[c], slack / sizes_[c]));
+        for (uint32_t k = most + 1; k-- > 0 && !timeout_;) {
+            take_[c] = k;
+            enumerate(c + 1, slack - k * sizes_[c], sum + k * sizes_[c]);
+        }
+        take_[c] = 0;
+    }
+
+    void apply(const Completion& completion, Size largest, int sign) {
+        if (sign > 0)
+            bins_.push_back({largest});
+        for (size_t p = completion.begin; p < completion.end; ++p) {
+            auto [c, k] = picks_[p];
+            left_[c] -= sign * int64_t(k);
+            remaining_ -= sign * int64_t(k) * sizes_[c];
+            items_left_ -= sign * int64_t(k);
+            if (sign > 0)
+                bins_.back().insert(bins_.back().end(), k, sizes_[c]);
+        }
+        if (sign < 0)
+            bins_.pop_back();
+    }
+
+    void search() {
+        if (items_left_ == 0) {
+            if (bins_.size() < best_) {
+                best_ = bins_.size();
+                best_bins_ = bins_;
+                improved_ = true;
+            }
+            return;
+        }
+        if (done() || bound() >= int64_t(best_))
+            return;
+
+        // O maior item restante abre a bin
+        size_t x = 0;
+        while (left_[x] == 0)
+            ++x;
+        Size largest = sizes_[x];
+        --left_[x];
+        remaining_ -= largest;
+        --items_left_;
+
+        size_t picks_mark = picks_.size(), first = completions_.size();
+        enumerate(0, capacity_ - largest, 0);
+        std::stable_sort(completions_.begin() + first, completions_.end(),
+                         [](const Completion& a, const Completion& b) { return a.sum > b.sum; });
+
+        for (size_t i = first; i < completions_.size() && !done(); ++i) {
+            Completion completion = completions_[i];
+            apply(completion, largest, +1);
+            search();
+            apply(completion, largest, -1);
+        }
+
+        completions_.resize(first);
+        picks_.resize(picks_mark);
+        ++left_[x];
+        remaining_ += largest;
+        ++items_left_;
+    }
+};
+
+// Modo exato: redução, limitantes e bin completion a partir da melhor
+// heurística. finished indica que a otimalidade foi provada dentro do tempo
+template <typename Size>
+SearchResult<Size> solve_exact(const std::vector<Size>& items, Size capacity, const SearchOptions& options) {
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + options.time_budget();
+
+    SearchResult<Size> result{};
+    result.bounds = lower_bounds(std::vector<int64_t>(items.begin(), items.end()), capacity);
+    result.distinct_sizes = ItemClasses<Size>(items).distinct();
+
+    SearchOptions heuristics = options;
+    heuristics.heuristic.clear();
+    std::vector<Size> initial = best_heuristic(items, capacity, heuristics, result);
+    result.packing = pack_first_fit(initial, capacity);
+
+    std::vector<Size> sorted = items;
+    std::sort(sorted.begin(), sorted.end(), std::greater<Size>());
+    std::vector<bool> removed;
+    auto fixed = mt_reduction(sorted, capacity, removed);
+
+    std::vector<Size> rest;
+    for (size_t i = 0; i < sorted.size(); ++i)
+        if (!removed[i])
+            rest.push_back(sorted[i]);
+
+    // O limitante do que sobrou da redução, somado às bins fixadas, também
+    // vale para a instância original
+    result.bounds.reduced = fixed.size() + lower_bounds(std::vector<int64_t>(rest.begin(), rest.end()), capacity).best();
+    int64_t bound = result.bounds.best();
+
+    size_t incumbent = result.packing.bins();
+    BinCompletion<Size> bnb(rest, capacity, incumbent - std::min(incumbent, fixed.size()),
+                            bound - int64_t(fixed.size()), deadline);
+    result.finished = bnb.run();
+    result.evaluations = bnb.nodes();
+
+    if (bnb.improved() && fixed.size() + bnb.best() < incumbent) {
+        // Bins fixadas pela redução primeiro, depois as do bin completion
+        Packing<Size> packing;
+        for (const auto& bin : fixed) {
+            for (size_t i : bin)
+                packing.items.push_back(sorted[i]);
+            packing.offsets.push_back(packing.items.size());
+        }
+        for (const auto& bin : bnb.best_bins()) {
+            packing.items.insert(packing.items.end(), bin.begin(), bin.end());
+            packing.offsets.push_back(packing.items.size());
+        }
+        result.packing = std::move(packing);
+        result.best_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    result.optimal = result.finished || int64_t(result.packing.bins()) <= bound;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+#endif
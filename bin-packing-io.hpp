@@ -0,0 +1,308 @@
+/*
+  Leitura e escrita das instâncias de Bin Packing, usadas por bin-packing.cpp,
+  bin-packing-new.cpp e bin-packing-convert.cpp.
+
+  Formato texto (.dat): "capacidade n itens" com tamanhos inteiros, ou
+  "n itens" com tamanhos fracionários em (0, 1] no bin-packing-new.
+
+  Formato binário: cabeçalho InstanceHeader de 32 bytes seguido dos n itens
+  contíguos no tipo indicado, na ordem de bytes da máquina. O arquivo é
+  mapeado com mmap e os itens são copiados de uma vez, sem nenhum parse.
+*/
+
+#ifndef BIN_PACKING_IO_HPP
+#define BIN_PACKING_IO_HPP
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <cerrno>
+#include <charconv>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+inline const char INSTANCE_MAGIC[8] = {'B', 'P', 'I', 'N', 'S', 'T', '0', '1'};
+
+enum class ItemType : uint32_t {
+    Int64 = 0,    // tamanhos inteiros (bin-packing.cpp)
+    Fixed32 = 1,  // valor * scale em int32 (bin-packing-new.cpp)
+};
+
+struct InstanceHeader {
+    char magic[8];
+    uint32_t type;
+    uint32_t scale;     // 1 para Int64
+    int64_t capacity;   // na mesma escala dos itens
+    uint64_t n;
+};
+
+static_assert(sizeof(InstanceHeader) == 32, "cabeçalho binário deve ter 32 bytes");
+
+template <typename Size>
+struct Instance {
+    Size capacity = 0;
+    std::vector<Size> items;
+};
+
+// Conteúdo inteiro de um arquivo ("-" é a entrada padrão). Arquivos comuns,
+// inclusive a entrada padrão redirecionada de um arquivo, são mapeados com
+// mmap; pipes são lidos para um buffer
+class InputBuffer {
+public:
+    explicit InputBuffer(const std::string& path) {
+        int fd = path == "-" ? STDIN_FILENO : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), "não foi possível abrir " + path);
+
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED) {
+                madvise(map, st.st_size, MADV_SEQUENTIAL);
+                map_ = static_cast<const char*>(map);
+                size_ = st.st_size;
+            }
+        }
+
+        if (!map_) {
+            char chunk[1 << 16];
+            ssize_t got;
+            while ((got = ::read(fd, chunk, sizeof chunk)) > 0)
+                buffer_.insert(buffer_.end(), chunk, chunk + got);
+            size_ = buffer_.size();
+        }
+
+        if (fd != STDIN_FILENO)
+            ::close(fd);
+    }
+
+    ~InputBuffer() {
+        if (map_)
+            munmap(const_cast<char*>(map_), size_);
+    }
+
+    InputBuffer(const InputBuffer&) = delete;
+    InputBuffer& operator=(const InputBuffer&) = delete;
+
+    const char* data() const { return map_ ? map_ : buffer_.data(); }
+    size_t size() const { return size_; }
+
+    bool is_binary() const {
+        return size_ >= sizeof(InstanceHeader) && std::memcmp(data(), INSTANCE_MAGIC, sizeof INSTANCE_MAGIC) == 0;
+    }
+
+private:
+    const char* map_ = nullptr;
+    std::vector<char> buffer_;
+    size_t size_ = 0;
+};
+
+// Lê números em sequência com std::from_chars, sem iostream nem locale
+class TextReader {
+public:
+    TextReader(const char* begin, const char* end) : p_(begin), end_(end) {}
+
+    const char* position() const { return p_; }
+
+    // Retorna false no fim do texto; lança exceção se o próximo token não
+    // for um número do tipo pedido
+    template <typename T>
+    bool next(T& value) {
+        while (p_ < end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t'))
+            ++p_;
+        if (p_ == end_)
+            return false;
+
+        auto [ptr, ec] = std::from_chars(p_, end_, value);
+        if (ec != std::errc())
+            throw std::runtime_error("número inválido na entrada: \"" + std::string(p_, std::min<size_t>(end_ - p_, 16)) + "\"");
+        p_ = ptr;
+        return true;
+    }
+
+    template <typename T>
+    T expect() {
+        T value;
+        if (!next(value))
+            throw std::runtime_error("entrada terminou antes do esperado");
+        return value;
+    }
+
+private:
+    const char* p_;
+    const char* end_;
+};
+
+inline size_t read_count(TextReader& reader) {
+    int64_t n = reader.expect<int64_t>();
+    if (n < 0)
+        throw std::runtime_error("número de itens negativo");
+    return n;
+}
+
+// Capacidade positiva e itens não negativos. Itens maiores que a capacidade
+// são aceitos e ocupam uma bin sozinhos; os de tamanho zero cabem em qualquer
+// bin
+template <typename Size>
+void validate(const Instance<Size>& instance) {
+    if (instance.capacity <= 0)
+        throw std::runtime_error("capacidade deve ser positiva");
+    for (Size item : instance.items)
+        if (item < 0)
+            throw std::runtime_error("item de tamanho negativo: " + std::to_string(item));
+}
+
+// Valida o cabeçalho e copia os itens de uma instância binária que começa em
+// data; size é o que resta da entrada a partir dali
+template <typename Size>
+Instance<Size> read_binary(const char* data, size_t size, ItemType type, uint32_t scale) {
+    InstanceHeader header;
+    std::memcpy(&header, data, sizeof header);
+    if (header.type != uint32_t(type) || header.scale != scale)
+        throw std::runtime_error("instância binária com tipo ou escala incompatível com este programa");
+    if (header.n > (size - sizeof header) / sizeof(Size))
+        throw std::runtime_error("instância binária truncada");
+
+    Instance<Size> instance;
+    instance.capacity = Size(header.capacity);
+    instance.items.resize(header.n);
+    std::memcpy(instance.items.data(), data + sizeof header, header.n * sizeof(Size));
+    validate(instance);
+    return instance;
+}
+
+template <typename Size>
+Instance<Size> read_binary(const InputBuffer& input, ItemType type, uint32_t scale) {
+    return read_binary<Size>(input.data(), input.size(), type, scale);
+}
+
+inline Instance<int64_t> read_integer_text(TextReader& reader) {
+    Instance<int64_t> instance;
+    instance.capacity = reader.expect<int64_t>();
+    instance.items.resize(read_count(reader));
+    for (int64_t& item : instance.items)
+        item = reader.expect<int64_t>();
+    validate(instance);
+    return instance;
+}
+
+// Instância de bin-packing.cpp, em texto ou binário
+inline Instance<int64_t> load_integer_instance(const InputBuffer& input) {
+    if (input.is_binary())
+        return read_binary<int64_t>(input, ItemType::Int64, 1);
+
+    TextReader reader(input.data(), input.data() + input.size());
+    return read_integer_text(reader);
+}
+
+// Instância de bin-packing-new.cpp: capacidade 1 e tamanhos em ponto fixo
+inline Instance<int32_t> load_fixed_instance(const InputBuffer& input, int32_t scale) {
+    if (input.is_binary())
+        return read_binary<int32_t>(input, ItemType::Fixed32, scale);
+
+    TextReader reader(input.data(), input.data() + input.size());
+    Instance<int32_t> instance;
+    instance.capacity = scale;
+    instance.items.resize(read_count(reader));
+    for (int32_t& item : instance.items)
+        item = static_cast<int32_t>(std::llround(reader.expect<double>() * scale));
+    validate(instance);
+    return instance;
+}
+
+inline Instance<int64_t> load_integer_instance(const std::string& path) {
+    return load_integer_instance(InputBuffer(path));
+}
+
+inline Instance<int32_t> load_fixed_instance(const std::string& path, int32_t scale) {
+    return load_fixed_instance(InputBuffer(path), scale);
+}
+
+// Instâncias inteiras concatenadas numa mesma entrada (modo lote), em texto
+// ou binário, podendo misturar os dois formatos
+class InstanceSequence {
+public:
+    explicit InstanceSequence(const InputBuffer& input) : p_(input.data()), end_(input.data() + input.size()) {}
+
+    // Retorna false no fim da entrada
+    bool next(Instance<int64_t>& instance) {
+        while (p_ < end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t'))
+            ++p_;
+        if (p_ == end_)
+            return false;
+
+        size_t left = end_ - p_;
+        if (left >= sizeof(InstanceHeader) && std::memcmp(p_, INSTANCE_MAGIC, sizeof INSTANCE_MAGIC) == 0) {
+            instance = read_binary<int64_t>(p_, left, ItemType::Int64, 1);
+            p_ += sizeof(InstanceHeader) + instance.items.size() * sizeof(int64_t);
+        } else {
+            TextReader reader(p_, end_);
+            instance = read_integer_text(reader);
+            p_ = reader.position();
+        }
+        return true;
+    }
+
+private:
+    const char* p_;
+    const char* end_;
+};
+
+template <typename Size>
+void write_binary(const std::string& path, const Instance<Size>& instance, ItemType type, uint32_t scale) {
+    InstanceHeader header{};
+    std::memcpy(header.magic, INSTANCE_MAGIC, sizeof INSTANCE_MAGIC);
+    header.type = uint32_t(type);
+    header.scale = scale;
+    header.capacity = instance.capacity;
+    header.n = instance.items.size();
+
+    FILE* out = path == "-" ? stdout : std::fopen(path.c_str(), "wb");
+    if (!out)
+        throw std::system_error(errno, std::generic_category(), "não foi possível criar " + path);
+    bool ok = std::fwrite(&header, sizeof header, 1, out) == 1 &&
+              std::fwrite(instance.items.data(), sizeof(Size), header.n, out) == header.n;
+    ok = (out == stdout ? std::fflush(out) : std::fclose(out)) == 0 && ok;
+    if (!ok)
+        throw std::runtime_error("erro ao gravar " + path);
+}
+
+// Grava no formato texto do programa correspondente: inteiros com a
+// capacidade (scale == 1) ou frações sem a capacidade
+template <typename Size>
+void write_text(const std::string& path, const Instance<Size>& instance, uint32_t scale) {
+    FILE* out = path == "-" ? stdout : std::fopen(path.c_str(), "w");
+    if (!out)
+        throw std::system_error(errno, std::generic_category(), "não foi possível criar " + path);
+
+    if (scale == 1)
+        std::fprintf(out, "%lld\n", (long long)instance.capacity);
+    std::fprintf(out, "%zu\n", instance.items.size());
+
+    // Casas decimais suficientes para recuperar o valor em ponto fixo
+    int digits = 0;
+    for (uint32_t s = scale; s > 1; s /= 10)
+        ++digits;
+    for (Size item : instance.items) {
+        if (scale == 1)
+            std::fprintf(out, "%lld\n", (long long)item);
+        else
+            std::fprintf(out, "%.*f\n", digits, double(item) / scale);
+    }
+
+    bool ok = (out == stdout ? std::fflush(out) : std::fclose(out)) == 0;
+    if (!ok)
+        throw std::runtime_error("erro ao gravar " + path);
+}
+
+#endif
@@ -1,152 +1,157 @@
 #include <iostream>
 #include <vector>
-#include <random>
 #include <algorithm>
 #include <numeric>
-#include <thread>
-#include <chrono>
-#include <future>
 #include <stdexcept>
-#include <atomic>
+#include <cstdint>
+#include <string>
 #include <iomanip>
+#include <cmath>
 
-void print_items(const std::vector<float>& items);
-std::vector<float> permute(const std::vector<float>& initial);
-std::vector<float> bin_packing_ff(std::vector<float> items, float capacity);
-size_t gen_random_index(size_t size);
-std::vector<std::vector<float>> fitness_first_fit(const std::vector<float>& items, float capacity);
+#include "bin-packing.hpp"
+#include "bin-packing-io.hpp"
 
-std::atomic<bool> stop_execution(false);
-std::vector<float> current;
+// Sizes are read as fixed-point integers in units of 1 / FIXED_SCALE, so
+// every capacity comparison is exact and no epsilon is needed
+const int32_t FIXED_SCALE = 1000000;
+
+void print_items(const int32_t* begin, const int32_t* end);
 
 int main(int argc, char* argv[]) {
     std::cout << "Bin Packing Algorithm with local search (floating-point version)\n";
     std::cout << std::fixed << std::setprecision(2);
 
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <max_execution_time (s)>\n";
+        std::cerr << "Usage: " << argv[0] << " <max_execution_time (s)> [--threads N] [--heuristic ff|bf|wf|ffd|bfd|wfd|best] [--evaluator tree|scan|auto] [--instance file.dat|file.bin] [--engine permutation|bins]\n";
+        std::cerr << "  [--telemetry file.json] [--checkpoint file.bin] [--interval s] [--resume file.bin]\n";
         return 1;
     }
 
-    int time_limit = std::stoi(argv[1]);
-    const float capacity = 1.0f;  // Fixed bin capacity
-    int n;
-    
-    std::cin >> n;
-    std::vector<float> items(n);
-    
-    for (float& item : items) {
-        std::cin >> item;
-        if (item <= 0.0f || item > 1.0f) {
-            std::cerr << "Error: All items must be between 0 and 1\n";
-            return 1;
+    SearchOptions options;
+    options.time_limit = std::stoi(argv[1]);
+    std::string heuristic = "best";
+    std::string path = "-", resume_path;
+    options.checkpoint_scale = FIXED_SCALE;
+    for (int i = 2; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--threads")
+            options.threads = std::max(1, std::stoi(argv[++i]));
+        else if (std::string(argv[i]) == "--heuristic")
+            heuristic = argv[++i];
+        else if (std::string(argv[i]) == "--instance")
+            path = argv[++i];
+        else if (std::string(argv[i]) == "--telemetry")
+            options.telemetry = argv[++i];
+        else if (std::string(argv[i]) == "--checkpoint")
+            options.checkpoint = argv[++i];
+        else if (std::string(argv[i]) == "--interval")
+            options.checkpoint_interval = std::max(1, std::stoi(argv[++i]));
+        else if (std::string(argv[i]) == "--resume")
+            resume_path = argv[++i];
+        else if (std::string(argv[i]) == "--engine") {
+            std::string engine = argv[++i];
+            if (engine == "bins")
+                options.annealing = true;
+            else if (engine != "permutation") {
+                std::cerr << "Unknown engine: " << engine << '\n';
+                return 1;
+            }
+        }
+        else if (std::string(argv[i]) == "--evaluator") {
+            std::string evaluator = argv[++i];
+            if (evaluator == "tree")
+                options.evaluator = EvaluatorKind::Tree;
+            else if (evaluator == "scan")
+                options.evaluator = EvaluatorKind::Scan;
+            else if (evaluator != "auto") {
+                std::cerr << "Unknown evaluator: " << argv[i] << '\n';
+                return 1;
+            }
         }
     }
 
-    current = permute(items);
-
-    auto future_result = std::async(std::launch::async, bin_packing_ff, items, capacity);
+    if (heuristic != "best") {
+        if (std::find(HEURISTICS.begin(), HEURISTICS.end(), heuristic) == HEURISTICS.end()) {
+            std::cerr << "Unknown heuristic: " << heuristic << '\n';
+            return 1;
+        }
+        options.heuristic = heuristic;
+    }
 
+    // Reads stdin when --instance is not given, as text or binary
+    Instance<int32_t> instance;
     try {
-        auto status = future_result.wait_for(std::chrono::seconds(time_limit));
-        if (status == std::future_status::ready) {
-            std::cout << "Solution found before time limit!\n";
-        } else {
-            stop_execution = true;
-            std::cout << "Time limit exceeded!\n";
-        }
+        instance = load_fixed_instance(path, FIXED_SCALE);
     } catch (const std::exception& e) {
-        std::cerr << "Exception: " << e.what() << '\n';
+        std::cerr << "Error reading instance: " << e.what() << '\n';
+        return 1;
     }
+    const int32_t capacity = FIXED_SCALE;  // Fixed bin capacity (1.0)
+    const std::vector<int32_t>& items = instance.items;
 
-    auto bins = fitness_first_fit(current, capacity);
-
-    for (size_t i = 0; i < bins.size(); ++i) {
-        float sum = std::accumulate(bins[i].begin(), bins[i].end(), 0.0f);
-        std::cout << "Bin " << i + 1 << " (sum: " << sum << "): ";
-        print_items(bins[i]);
+    for (int32_t item : items) {
+        if (item <= 0 || item > capacity) {
+            std::cerr << "Error: All items must be between 0 and 1\n";
+            return 1;
+        }
     }
 
-    std::cout << "Number of bins used: " << bins.size() << '\n';
-    return 0;
-}
-
-std::vector<float> bin_packing_ff(std::vector<float> items, float capacity) {
-    int n = items.size();
-    int best_fitness = fitness_first_fit(items, capacity).size();
-
-    while (!stop_execution) {
-        int k = std::min(100, n);
-        std::vector<std::vector<float>> neighbors(k);
-
-        for (int i = 0; i < k; ++i) {
-            int a = gen_random_index(n), b;
-            do {
-                b = gen_random_index(n);
-            } while (a == b);
-
-            auto neighbor = items;
-            std::swap(neighbor[a], neighbor[b]);
-            neighbors[i] = neighbor;
+    // The checkpoint holds the incumbent's order, used as the initial solution
+    Instance<int32_t> resume;
+    if (!resume_path.empty()) {
+        try {
+            resume = load_fixed_instance(resume_path, FIXED_SCALE);
+        } catch (const std::exception& e) {
+            std::cerr << "Error reading checkpoint: " << e.what() << '\n';
+            return 1;
         }
-
-        for (const auto& neighbor : neighbors) {
-            int fit = fitness_first_fit(neighbor, capacity).size();
-            if (fit < best_fitness) {
-                current = neighbor;
-                best_fitness = fit;
-                // Early exit if perfect solution found (unlikely for floating-point)
-                if (best_fitness == 1) break;
-            }
+        if (!same_instance(items, capacity, resume)) {
+            std::cerr << "Checkpoint does not match the instance\n";
+            return 1;
         }
     }
 
-    return current;
-}
+    SearchResult<int32_t> result;
+    try {
+        result = solve(items, capacity, options, resume.items);
+    } catch (const std::exception& e) {
+        std::cerr << "Exception: " << e.what() << '\n';
+        return 1;
+    }
 
-std::vector<std::vector<float>> fitness_first_fit(const std::vector<float>& items, float capacity) {
-    std::vector<std::vector<float>> bins;
-    const float epsilon = 1e-5f;  // For floating-point comparisons
-
-    for (float item : items) {
-        bool placed = false;
-        for (auto& bin : bins) {
-            float sum = std::accumulate(bin.begin(), bin.end(), 0.0f);
-            if (sum + item <= capacity + epsilon) {
-                bin.push_back(item);
-                placed = true;
-                break;
-            }
-        }
+    if (!result.heuristic.empty())
+        std::cout << "Initial heuristic: " << result.heuristic << " (" << result.heuristic_bins << " bins)\n";
 
-        if (!placed) {
-            bins.push_back({item});
-        }
+    std::cout << "Distinct sizes: " << result.distinct_sizes << " of " << items.size() << " items\n";
+
+    if (result.finished)
+        std::cout << "Solution found before time limit!\n";
+    else
+        std::cout << "Time limit exceeded!\n";
+
+    const auto& packing = result.packing;
+    size_t bins = packing.bins();
+    for (size_t i = 0; i < bins; ++i) {
+        int64_t sum = std::accumulate(packing.begin(i), packing.end(i), int64_t(0));
+        std::cout << "Bin " << i + 1 << " (sum: " << double(sum) / FIXED_SCALE << "): ";
+        print_items(packing.begin(i), packing.end(i));
     }
 
-    return bins;
-}
+    std::cout << "Number of bins used: " << bins << '\n';
 
-size_t gen_random_index(size_t size) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<size_t> distrib(0, size - 1);
-    return distrib(gen);
+    const LowerBounds& bounds = result.bounds;
+    int64_t gap = bins - bounds.best();
+    std::cout << "Lower bound: " << bounds.best() << " (L1 = " << bounds.l1
+              << ", L2 = " << bounds.l2 << ", DFF = " << bounds.dff << ")\n";
+    std::cout << "Optimality gap: " << gap << " bins ("
+              << (bins == 0 ? 0.0 : 100.0 * gap / bins) << "%)\n";
+    return 0;
 }
 
-void print_items(const std::vector<float>& items) {
-    for (size_t i = 0; i < items.size(); ++i) {
-        std::cout << items[i];
-        if (i < items.size() - 1)
+void print_items(const int32_t* begin, const int32_t* end) {
+    for (const int32_t* item = begin; item != end; ++item) {
+        std::cout << double(*item) / FIXED_SCALE;
+        if (item + 1 != end)
             std::cout << ", ";
     }
     std::cout << '\n';
 }
-
-std::vector<float> permute(const std::vector<float>& initial) {
-    auto permutation = initial;
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::shuffle(permutation.begin(), permutation.end(), gen);
-    return permutation;
-}
\ No newline at end of file
@@ -1,145 +1,318 @@
 #include <iostream>
 #include <vector>
-#include <random>
 #include <algorithm>
-#include <numeric>
-#include <thread>
-#include <chrono>
-#include <future>
 #include <stdexcept>
-#include <atomic>
+#include <cstdint>
+#include <string>
+#include <iomanip>
+#include <chrono>
+#include <sstream>
 
-void print_items(const std::vector<int>& items);
-std::vector<int> permute(const std::vector<int>& initial);
-std::vector<int> bin_packing_ff(std::vector<int> items, int capacity);
-size_t gen_random_index(size_t size);
-std::vector<std::vector<int>> fitness_first_fit(const std::vector<int>& items, int capacity);
+#include "bin-packing.hpp"
+#include "bin-packing-io.hpp"
+#include "bin-packing-exact.hpp"
+#include "bin-packing-batch.hpp"
 
-std::atomic<bool> stop_execution(false);
-std::vector<int> current;
+void print_items(const int64_t* begin, const int64_t* end, std::ostream& out = std::cout);
+int run_stream(int argc, char* argv[]);
+int run_batch_mode(const std::string& path, const SearchOptions& options, bool exact);
 
 int main(int argc, char* argv[]) {
     std::cout << "Algoritmo de Bin Packing com busca local" << std::endl;
 
     if (argc < 2) {
-        std::cerr << "Uso: " << argv[0] << " <tempo_maximo_execucao (s)>" << std::endl;
+        std::cerr << "Uso: " << argv[0] << " <tempo_maximo_execucao (s)> [--threads N] [--heuristica ff|bf|wf|ffd|bfd|wfd|melhor] [--avaliador arvore|varredura|auto] [--instancia arquivo.dat|arquivo.bin] [--motor permutacao|bins] [--exato]" << std::endl;
+        std::cerr << "  [--telemetria arquivo.json] [--checkpoint arquivo.bin] [--intervalo s] [--retomar arquivo.bin]" << std::endl;
+        std::cerr << "  [--lote diretorio|arquivo] [--orcamento ms]" << std::endl;
+        std::cerr << "  ou: " << argv[0] << " --stream ff|bf|harmonico [--classes K] [--menor-item S] [--max-abertas N]" << std::endl;
+        std::cerr << "  (ff e bf fecham a bin mais cheia ao abrir outra com N abertas; 1024 por padrão, 0 sem limite)" << std::endl;
         return 1;
     }
 
-    int time_limit = std::stoi(argv[1]);
-    int capacity, n;
+    if (std::string(argv[1]) == "--stream")
+        return run_stream(argc, argv);
 
-    std::cin >> capacity >> n;
-    std::vector<int> items(n);
-
-    for (int& item : items)
-        std::cin >> item;
+    SearchOptions options;
+    options.time_limit = std::stoi(argv[1]);
+    std::string heuristic = "melhor";
+    std::string path = "-", resume_path, batch_path;
+    bool exact = false;
+    for (int i = 2; i < argc; ++i) {
+        if (std::string(argv[i]) == "--exato")
+            exact = true;
+        else if (i + 1 == argc)
+            break;
+        else if (std::string(argv[i]) == "--threads")
+            options.threads = std::max(1, std::stoi(argv[++i]));
+        else if (std::string(argv[i]) == "--heuristica")
+            heuristic = argv[++i];
+        else if (std::string(argv[i]) == "--instancia")
+            path = argv[++i];
+        else if (std::string(argv[i]) == "--lote")
+            batch_path = argv[++i];
+        else if (std::string(argv[i]) == "--orcamento")
+            options.budget_ms = std::max(1, std::stoi(argv[++i]));
+        else if (std::string(argv[i]) == "--telemetria")
+            options.telemetry = argv[++i];
+        else if (std::string(argv[i]) == "--checkpoint")
+            options.checkpoint = argv[++i];
+        else if (std::string(argv[i]) == "--intervalo")
+            options.checkpoint_interval = std::max(1, std::stoi(argv[++i]));
+        else if (std::string(argv[i]) == "--retomar")
+            resume_path = argv[++i];
+        else if (std::string(argv[i]) == "--motor") {
+            std::string engine = argv[++i];
+            if (engine == "bins")
+                options.annealing = true;
+            else if (engine != "permutacao") {
+                std::cerr << "Motor desconhecido: " << engine << std::endl;
+                return 1;
+            }
+        }
+        else if (std::string(argv[i]) == "--avaliador") {
+            std::string evaluator = argv[++i];
+            if (evaluator == "arvore")
+                options.evaluator = EvaluatorKind::Tree;
+            else if (evaluator == "varredura")
+                options.evaluator = EvaluatorKind::Scan;
+            else if (evaluator != "auto") {
+                std::cerr << "Avaliador desconhecido: " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+    }
 
-    current = permute(items);
+    if (heuristic != "melhor") {
+        if (std::find(HEURISTICS.begin(), HEURISTICS.end(), heuristic) == HEURISTICS.end()) {
+            std::cerr << "Heurística desconhecida: " << heuristic << std::endl;
+            return 1;
+        }
+        options.heuristic = heuristic;
+    }
 
-    // Lança a busca local em paralelo
-    auto future_result = std::async(std::launch::async, bin_packing_ff, items, capacity);
+    if (!batch_path.empty())
+        return run_batch_mode(batch_path, options, exact);
 
+    // Sem --instancia, lê da entrada padrão, em texto ou binário
+    Instance<int64_t> instance;
     try {
-        auto status = future_result.wait_for(std::chrono::seconds(time_limit));
-        if (status == std::future_status::ready) {
-            std::cout << "Resultado encontrado antes do tempo limite!" << std::endl;
-        } else {
-            stop_execution = true;
-            std::cout << "Tempo limite excedido!" << std::endl;
+        instance = load_integer_instance(path);
+    } catch (const std::exception& e) {
+        std::cerr << "Erro na leitura da instância: " << e.what() << std::endl;
+        return 1;
+    }
+    int64_t capacity = instance.capacity;
+    const std::vector<int64_t>& items = instance.items;
+
+    // O checkpoint guarda a ordem da incumbente, que vira a solução inicial
+    Instance<int64_t> resume;
+    if (!resume_path.empty()) {
+        try {
+            resume = load_integer_instance(resume_path);
+        } catch (const std::exception& e) {
+            std::cerr << "Erro na leitura do checkpoint: " << e.what() << std::endl;
+            return 1;
+        }
+        if (!same_instance(items, capacity, resume)) {
+            std::cerr << "Checkpoint não corresponde à instância" << std::endl;
+            return 1;
         }
+    }
+
+    if (heuristic[0] != 'f' && heuristic != "melhor" && capacity > MAX_BUCKET_CAPACITY)
+        std::cerr << "Heurística " << heuristic << " ignorada: capacidade acima de "
+                  << MAX_BUCKET_CAPACITY << std::endl;
+
+    SearchResult<int64_t> result;
+    try {
+        result = exact ? solve_exact(items, capacity, options) : solve(items, capacity, options, resume.items);
     } catch (const std::exception& e) {
         std::cerr << "Exceção: " << e.what() << std::endl;
+        return 1;
     }
 
-    auto bins = fitness_first_fit(current, capacity);
+    if (!result.heuristic.empty())
+        std::cout << "Heurística inicial: " << result.heuristic << " (" << result.heuristic_bins << " bins)" << std::endl;
+
+    std::cout << "Tamanhos distintos: " << result.distinct_sizes << " de " << items.size() << " itens" << std::endl;
+
+    if (result.finished)
+        std::cout << "Resultado encontrado antes do tempo limite!" << std::endl;
+    else
+        std::cout << "Tempo limite excedido!" << std::endl;
 
-    for (size_t i = 0; i < bins.size(); ++i) {
+    const auto& packing = result.packing;
+    size_t bins = packing.bins();
+    for (size_t i = 0; i < bins; ++i) {
         std::cout << "Bin " << i + 1 << ": ";
-        print_items(bins[i]);
+        print_items(packing.begin(i), packing.end(i));
     }
 
-    std::cout << "Número de bins utilizadas: " << bins.size() << std::endl;
+    std::cout << "Número de bins utilizadas: " << bins << std::endl;
+    if (result.optimal)
+        std::cout << "Solução ótima comprovada" << std::endl;
+
+    // O ótimo provado pelo modo exato pode ficar acima do limitante
+    const LowerBounds& bounds = result.bounds;
+    int64_t gap = result.optimal ? 0 : bins - bounds.best();
+    std::cout << "Limitante inferior: " << bounds.best() << " (L1 = " << bounds.l1
+              << ", L2 = " << bounds.l2 << ", DFF = " << bounds.dff;
+    if (bounds.reduced)
+        std::cout << ", após a redução = " << bounds.reduced;
+    std::cout << ")" << std::endl;
+    std::cout << "Gap de otimalidade: " << gap << " bins (" << std::fixed << std::setprecision(2)
+              << (bins == 0 ? 0.0 : 100.0 * gap / bins) << "%)" << std::endl;
     return 0;
 }
 
-// Algoritmo de busca local usando permutação de pares
-std::vector<int> bin_packing_ff(std::vector<int> items, int capacity) {
-    int n = items.size();
-    int best_fitness = fitness_first_fit(items, capacity).size();
+// Imprime itens da bin formatadamente
+void print_items(const int64_t* begin, const int64_t* end, std::ostream& out) {
+    for (const int64_t* item = begin; item != end; ++item) {
+        out << *item;
+        if (item + 1 != end)
+            out << ", ";
+    }
+    out << '\n';
+}
+
+// Modo lote: cada instância é resolvida por uma thread do pool, com um só
+// worker e o orçamento de tempo por instância (--orcamento, ou o tempo
+// máximo), e impressa em ordem com a mesma lista de bins do modo normal
+int run_batch_mode(const std::string& path, const SearchOptions& options, bool exact) {
+    std::ios::sync_with_stdio(false);
+
+    std::vector<BatchJob> jobs;
+    try {
+        jobs = batch_jobs(path);
+    } catch (const std::exception& e) {
+        std::cerr << "Erro na leitura do lote: " << e.what() << std::endl;
+        return 1;
+    }
 
-    while (!stop_execution) {
-        int k = std::min(100, n);
-        std::vector<std::vector<int>> neighbors(k);
+    std::atomic<size_t> optimal{0}, failed{0};
+    auto solve_job = [&](BatchJob& job) {
+        std::ostringstream out;
+        try {
+            if (!job.path.empty())
+                job.instance = load_integer_instance(job.path);
 
-        for (int i = 0; i < k; ++i) {
-            int a = gen_random_index(n), b;
-            do {
-                b = gen_random_index(n);
-            } while (a == b);
+            // Com semente fixa, cada instância tem a sua, independente da
+            // thread que a resolveu
+            SearchOptions single = options;
+            single.threads = 1;
+            if (options.seed)
+                single.seed = options.seed + std::hash<std::string>()(job.name);
 
-            auto neighbor = items;
-            std::swap(neighbor[a], neighbor[b]);
-            neighbors[i] = neighbor;
-        }
+            const auto& instance = job.instance;
+            SearchResult<int64_t> result = exact ? solve_exact(instance.items, instance.capacity, single)
+                                                 : solve_inline(instance.items, instance.capacity, single);
 
-        for (const auto& neighbor : neighbors) {
-            int fit = fitness_first_fit(neighbor, capacity).size();
-            if (fit < best_fitness) {
-                current = neighbor;
-                best_fitness = fit;
+            size_t bins = result.packing.bins();
+            int64_t gap = result.optimal ? 0 : bins - result.bounds.best();
+            optimal += result.optimal;
+            out << "Instância " << job.name << ": " << bins << " bins, limitante " << result.bounds.best()
+                << ", gap " << gap << (result.optimal ? " (ótima)" : "") << ", " << std::fixed
+                << std::setprecision(3) << result.seconds << " s\n";
+            for (size_t i = 0; i < bins; ++i) {
+                out << "Bin " << i + 1 << ": ";
+                print_items(result.packing.begin(i), result.packing.end(i), out);
             }
+        } catch (const std::exception& e) {
+            ++failed;
+            out << "Instância " << job.name << ": erro: " << e.what() << '\n';
         }
-    }
+        return out.str();
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    run_batch(jobs, options.threads, solve_job, [](const std::string& text) { std::cout << text; });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 
-    return current;
+    double rate = jobs.size() / std::max(seconds, 1e-9);
+    std::cout << "Lote: " << jobs.size() << " instâncias, " << optimal << " ótimas comprovadas, " << failed
+              << " com erro, em " << std::fixed << std::setprecision(3) << seconds << " s ("
+              << std::setprecision(1) << rate << " instâncias/s, " << rate / options.threads
+              << " por thread)" << std::endl;
+    return failed ? 1 : 0;
 }
 
-// Função de avaliação usando First Fit
-std::vector<std::vector<int>> fitness_first_fit(const std::vector<int>& items, int capacity) {
-    std::vector<std::vector<int>> bins;
-
-    for (int item : items) {
-        bool placed = false;
-        for (auto& bin : bins) {
-            int sum = std::accumulate(bin.begin(), bin.end(), 0);
-            if (sum + item <= capacity) {
-                bin.push_back(item);
-                placed = true;
-                break;
-            }
-        }
+// Modo online: lê a capacidade e depois os itens até o fim da entrada,
+// imprimindo cada bin assim que ela é fechada
+int run_stream(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Regra online não informada" << std::endl;
+        return 1;
+    }
 
-        if (!placed)
-            bins.push_back({item});
+    std::string name = argv[2];
+    OnlineRule rule;
+    if (name == "ff")
+        rule = OnlineRule::FirstFit;
+    else if (name == "bf")
+        rule = OnlineRule::BestFit;
+    else if (name == "harmonico")
+        rule = OnlineRule::Harmonic;
+    else {
+        std::cerr << "Regra online desconhecida: " << name << std::endl;
+        return 1;
     }
 
-    return bins;
-}
+    int classes = 10;
+    int64_t min_item = 1;
+    size_t max_open = 1024;  // Sem --menor-item, quase nenhuma bin do ff e do bf fecha sozinha
+    for (int i = 3; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--classes")
+            classes = std::stoi(argv[++i]);
+        else if (std::string(argv[i]) == "--menor-item")
+            min_item = std::stoll(argv[++i]);
+        else if (std::string(argv[i]) == "--max-abertas")
+            max_open = std::stoull(argv[++i]);
+    }
 
-// Gera índice aleatório para troca
-size_t gen_random_index(size_t size) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> distrib(0, size - 1);
-    return distrib(gen);
-}
+    std::ios::sync_with_stdio(false);
 
-// Imprime itens da bin formatadamente
-void print_items(const std::vector<int>& items) {
-    for (size_t i = 0; i < items.size(); ++i) {
-        std::cout << items[i];
-        if (i < items.size() - 1)
-            std::cout << ", ";
+    int64_t capacity;
+    if (!(std::cin >> capacity) || capacity <= 0) {
+        std::cerr << "Capacidade inválida" << std::endl;
+        return 1;
     }
-    std::cout << '\n';
-}
 
-// Retorna uma permutação aleatória dos itens
-std::vector<int> permute(const std::vector<int>& initial) {
-    auto permutation = initial;
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::shuffle(permutation.begin(), permutation.end(), gen);
-    return permutation;
+    // cin continua ligado a cout, então as bins fechadas são enviadas antes
+    // de esperar pelo próximo item
+    auto emit = [](size_t id, const int64_t* begin, const int64_t* end) {
+        std::cout << "Bin " << id << ": ";
+        print_items(begin, end);
+    };
+
+    using Clock = std::chrono::steady_clock;
+    Clock::duration total{0}, worst{0};
+    size_t count = 0;
+
+    try {
+        OnlinePacker<int64_t> packer(rule, capacity, min_item, classes, max_open, emit);
+
+        int64_t item;
+        while (std::cin >> item) {
+            auto start = Clock::now();
+            packer.add(item);
+            auto elapsed = Clock::now() - start;
+            total += elapsed;
+            worst = std::max(worst, elapsed);
+            ++count;
+        }
+        packer.finish();
+
+        std::cout << "Número de bins utilizadas: " << packer.bins() << std::endl;
+        std::cout << "Máximo de bins abertas: " << packer.peak_open_bins() << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Exceção: " << e.what() << std::endl;
+        return 1;
+    }
+
+    // Latência da colocação de cada item, incluindo a entrega das bins que ela
+    // fecha; a leitura da entrada fica de fora
+    auto micros = [](Clock::duration d) { return std::chrono::duration<double, std::micro>(d).count(); };
+    std::cout << "Latência por item: média " << std::fixed << std::setprecision(3)
+              << (count == 0 ? 0.0 : micros(total) / count) << " us, máxima " << micros(worst) << " us" << std::endl;
+    return 0;
 }
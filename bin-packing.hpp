@@ -0,0 +1,1688 @@
+/*
+  Núcleo da busca local de Bin Packing, compartilhado por bin-packing.cpp
+  (tamanhos inteiros) e bin-packing-new.cpp (tamanhos fracionários lidos em
+  ponto fixo). Tudo é parametrizado pelo tipo inteiro Size dos tamanhos e
+  cargas, de modo que toda comparação de capacidade é exata.
+*/
+
+#ifndef BIN_PACKING_HPP
+#define BIN_PACKING_HPP
+
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <functional>
+#include <type_traits>
+#include <chrono>
+#include <future>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <limits>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <csignal>
+#include <cstdio>
+#include <unordered_map>
+#include <stdexcept>
+
+#include "bin-packing-io.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BIN_PACKING_X86 1
+#endif
+
+// Maior k das funções dual-viáveis u^(k) testadas no limitante inferior
+inline const int64_t DFF_MAX_K = 20;
+
+// Heurísticas construtivas aceitas; as terminadas em "d" ordenam os itens de
+// forma decrescente antes de empacotar
+inline const std::vector<std::string> HEURISTICS = {"ff", "bf", "wf", "ffd", "bfd", "wfd"};
+
+// Best Fit e Worst Fit indexam as bins por folga, com memória O(capacidade)
+inline const int64_t MAX_BUCKET_CAPACITY = 1 << 22;
+
+struct LowerBounds {
+    int64_t l1, l2, dff;
+    int64_t reduced = 0;  // Bins fixadas pela redução mais o limitante do resto (só no modo exato)
+
+    int64_t best() const { return std::max({l1, l2, dff, reduced}); }
+};
+
+// Limitantes inferiores para o número de bins, calculados sobre os tamanhos
+// ordenados: L1 (soma / capacidade), L2 de Martello e Toth e o melhor valor
+// das funções dual-viáveis u^(k) de Fekete e Schepers
+inline LowerBounds lower_bounds(std::vector<int64_t> sizes, int64_t capacity) {
+    LowerBounds lb{0, 0, 0};
+    if (sizes.empty() || capacity <= 0)
+        return lb;
+
+    // Um item maior que a bin ocupa uma bin inteira de qualquer forma
+    for (int64_t& w : sizes)
+        w = std::min(w, capacity);
+    std::sort(sizes.begin(), sizes.end());
+
+    size_t n = sizes.size();
+    std::vector<int64_t> prefix(n + 1, 0);
+    for (size_t i = 0; i < n; ++i)
+        prefix[i + 1] = prefix[i] + sizes[i];
+
+    auto ceil_div = [](int64_t a, int64_t b) { return a <= 0 ? 0 : (a + b - 1) / b; };
+    auto count_le = [&](int64_t x) {
+        return size_t(std::upper_bound(sizes.begin(), sizes.end(), x) - sizes.begin());
+    };
+
+    lb.l1 = ceil_div(prefix[n], capacity);
+
+    // L2: para cada alfa <= C/2, J1 = {w > C - alfa}, J2 = {C/2 < w <= C - alfa}
+    // e J3 = {alfa <= w <= C/2}; os itens de J3 só cabem na folga de J2
+    int64_t half = capacity / 2;
+    size_t half_end = count_le(half);
+    lb.l2 = lb.l1;
+    for (size_t i = 0; i <= half_end; ++i) {
+        if (i > 0 && i < half_end && sizes[i] == sizes[i - 1])
+            continue;
+
+        int64_t alpha = i < half_end ? sizes[i] : 0;
+        size_t j3_begin = i < half_end ? i : 0;
+        size_t j2_end = count_le(capacity - alpha);
+        int64_t j1 = n - j2_end;
+        int64_t j2 = j2_end - half_end;
+        int64_t j2_slack = j2 * capacity - (prefix[j2_end] - prefix[half_end]);
+        int64_t j3_sum = prefix[half_end] - prefix[j3_begin];
+        lb.l2 = std::max<int64_t>(lb.l2, j1 + j2 + ceil_div(j3_sum - j2_slack, capacity));
+    }
+
+    // u^(k)(w) = w se (k + 1) w / C é inteiro, senão floor((k + 1) w / C) C / (k + 1);
+    // as somas são feitas multiplicadas por (k + 1) para ficarem inteiras
+    lb.dff = lb.l1;
+    for (int64_t k = 1; k <= DFF_MAX_K; ++k) {
+        int64_t total = 0;
+        for (int64_t w : sizes) {
+            int64_t scaled = (k + 1) * w;
+            total += scaled % capacity == 0 ? scaled : scaled / capacity * capacity;
+        }
+        lb.dff = std::max<int64_t>(lb.dff, ceil_div(total, (k + 1) * capacity));
+    }
+
+    return lb;
+}
+
+// Árvore de segmentos com a menor carga de cada intervalo de bins, usada
+// para achar a primeira bin em que o item cabe em O(log n)
+template <typename Size>
+struct FirstFitTree {
+    size_t size = 1;
+    std::vector<Size> load;
+
+    void reset(size_t n) {
+        size = 1;
+        while (size < n)
+            size <<= 1;
+        load.assign(2 * size, 0);
+    }
+
+    // Índice da primeira bin com carga + item <= capacidade (bins ainda não
+    // abertas têm carga 0); retorna size se o item não cabe em nenhuma
+    size_t first_fit(Size item, Size capacity) const {
+        if (load[1] + item > capacity)
+            return size;
+
+        size_t node = 1;
+        while (node < size) {
+            node *= 2;
+            if (load[node] + item > capacity)
+                ++node;
+        }
+        return node - size;
+    }
+
+    // Copia as cargas das bins [0, m) e zera as bins [m, dirty), refazendo só
+    // os nós internos que cobrem esse trecho
+    void restore(const Size* loads, size_t m, size_t dirty) {
+        size_t hi = std::max(m, dirty);
+        std::copy(loads, loads + m, load.begin() + size);
+        std::fill(load.begin() + size + m, load.begin() + size + hi, 0);
+
+        for (size_t l = size, r = size + hi; l > 1 && l < r;) {
+            l /= 2;
+            r = (r + 1) / 2;
+            for (size_t node = l; node < r; ++node)
+                load[node] = std::min(load[2 * node], load[2 * node + 1]);
+        }
+    }
+
+    void add(size_t bin, Size item) {
+        size_t node = bin + size;
+        load[node] += item;
+        for (node /= 2; node >= 1; node /= 2)
+            load[node] = std::min(load[2 * node], load[2 * node + 1]);
+    }
+
+    Size load_of(size_t bin) const { return load[size + bin]; }
+    const Size* loads() const { return load.data() + size; }
+};
+
+// Varredura linear da primeira bin com carga <= limite. Com poucas bins
+// abertas ela é mais rápida que a árvore; as versões AVX2 e AVX-512 comparam
+// 8/16 cargas de 32 bits (4/8 de 64 bits) por instrução e a escolhida em
+// tempo de execução conforme a CPU
+enum class SimdLevel { Scalar, Avx2, Avx512 };
+
+inline SimdLevel detect_simd_level() {
+#ifdef BIN_PACKING_X86
+    if (__builtin_cpu_supports("avx512f"))
+        return SimdLevel::Avx512;
+    if (__builtin_cpu_supports("avx2"))
+        return SimdLevel::Avx2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+inline SimdLevel simd_level = detect_simd_level();
+
+template <typename Size>
+size_t scan_first_fit_scalar(const Size* load, size_t n, Size limit) {
+    for (size_t i = 0; i < n; ++i) {
+        if (load[i] <= limit)
+            return i;
+    }
+    return n;
+}
+
+#ifdef BIN_PACKING_X86
+__attribute__((target("avx2")))
+inline size_t scan_first_fit_avx2(const int32_t* load, size_t n, int32_t limit) {
+    __m256i lim = _mm256_set1_epi32(limit);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(load + i));
+        unsigned full = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, lim)));
+        if (full != 0xFF)
+            return i + __builtin_ctz(~full);
+    }
+    return i + scan_first_fit_scalar(load + i, n - i, limit);
+}
+
+__attribute__((target("avx2")))
+inline size_t scan_first_fit_avx2(const int64_t* load, size_t n, int64_t limit) {
+    __m256i lim = _mm256_set1_epi64x(limit);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(load + i));
+        unsigned full = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(v, lim)));
+        if (full != 0xF)
+            return i + __builtin_ctz(~full);
+    }
+    return i + scan_first_fit_scalar(load + i, n - i, limit);
+}
+
+__attribute__((target("avx512f")))
+inline size_t scan_first_fit_avx512(const int32_t* load, size_t n, int32_t limit) {
+    __m512i lim = _mm512_set1_epi32(limit);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __mmask16 fits = _mm512_cmple_epi32_mask(_mm512_loadu_si512(load + i), lim);
+        if (fits)
+            return i + __builtin_ctz(fits);
+    }
+    return i + scan_first_fit_scalar(load + i, n - i, limit);
+}
+
+__attribute__((target("avx512f")))
+inline size_t scan_first_fit_avx512(const int64_t* load, size_t n, int64_t limit) {
+    __m512i lim = _mm512_set1_epi64(limit);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __mmask8 fits = _mm512_cmple_epi64_mask(_mm512_loadu_si512(load + i), lim);
+        if (fits)
+            return i + __builtin_ctz(fits);
+    }
+    return i + scan_first_fit_scalar(load + i, n - i, limit);
+}
+#endif
+
+template <typename Size>
+size_t scan_first_fit(const Size* load, size_t n, Size limit) {
+#ifdef BIN_PACKING_X86
+    if constexpr (std::is_same_v<Size, int32_t> || std::is_same_v<Size, int64_t>) {
+        if (simd_level == SimdLevel::Avx512)
+            return scan_first_fit_avx512(load, n, limit);
+        if (simd_level == SimdLevel::Avx2)
+            return scan_first_fit_avx2(load, n, limit);
+    }
+#endif
+    return scan_first_fit_scalar(load, n, limit);
+}
+
+// Alternativa à FirstFitTree com a mesma interface: as cargas ficam num
+// vetor contíguo e a busca é a varredura vetorizada acima, O(bins abertas)
+template <typename Size>
+struct FirstFitScan {
+    std::vector<Size> load;
+
+    void reset(size_t n) { load.assign(n, 0); }
+
+    // Bins ainda não abertas têm carga 0, então a varredura para no máximo
+    // na primeira delas; retorna load.size() se o item não cabe em nenhuma
+    size_t first_fit(Size item, Size capacity) const {
+        return scan_first_fit(load.data(), load.size(), Size(capacity - item));
+    }
+
+    void restore(const Size* loads, size_t m, size_t dirty) {
+        size_t hi = std::max(m, dirty);
+        std::copy(loads, loads + m, load.begin());
+        std::fill(load.begin() + m, load.begin() + hi, 0);
+    }
+
+    void add(size_t bin, Size item) { load[bin] += item; }
+
+    Size load_of(size_t bin) const { return load[bin]; }
+    const Size* loads() const { return load.data(); }
+};
+
+// Índice das bins abertas por folga (capacidade - carga): uma lista encadeada
+// de bins para cada folga possível e um bitset de dois níveis com as folgas
+// não vazias, o que permite achar a menor folga >= w ou a maior folga em
+// O(C / 4096) palavras no pior caso, na prática O(1)
+struct ResidualBuckets {
+    std::vector<int32_t> head, next, prev;
+    std::vector<int64_t> residual;  // -1: bin fora do índice
+    std::vector<uint64_t> words, summary;
+
+    void reset(size_t n, int64_t capacity) {
+        size_t slots = capacity + 1;
+        head.assign(slots, -1);
+        words.assign((slots + 63) / 64, 0);
+        summary.assign((words.size() + 63) / 64, 0);
+        next.assign(n, -1);
+        prev.assign(n, -1);
+        residual.assign(n, -1);
+    }
+
+    // Aumenta o número de bins indexáveis sem mexer nas já inseridas
+    void grow(size_t n) {
+        next.resize(n, -1);
+        prev.resize(n, -1);
+        residual.resize(n, -1);
+    }
+
+    void insert(size_t bin, int64_t r) {
+        residual[bin] = r;
+        if (r < 0)
+            return;
+
+        next[bin] = head[r];
+        prev[bin] = -1;
+        if (head[r] >= 0)
+            prev[head[r]] = bin;
+        head[r] = bin;
+        words[r / 64] |= 1ULL << (r % 64);
+        summary[r / 4096] |= 1ULL << (r / 64 % 64);
+    }
+
+    void erase(size_t bin) {
+        int64_t r = residual[bin];
+        if (r < 0)
+            return;
+
+        if (prev[bin] >= 0)
+            next[prev[bin]] = next[bin];
+        else
+            head[r] = next[bin];
+        if (next[bin] >= 0)
+            prev[next[bin]] = prev[bin];
+
+        if (head[r] < 0) {
+            words[r / 64] &= ~(1ULL << (r % 64));
+            if (words[r / 64] == 0)
+                summary[r / 4096] &= ~(1ULL << (r / 64 % 64));
+        }
+        residual[bin] = -1;
+    }
+
+    // Menor folga não vazia >= w, ou -1
+    int64_t at_least(int64_t w) const {
+        if (w < 0)
+            w = 0;
+        size_t word = w / 64;
+        if (word >= words.size())
+            return -1;
+
+        uint64_t bits = words[word] & (~0ULL << (w % 64));
+        if (bits)
+            return word * 64 + __builtin_ctzll(bits);
+
+        for (size_t s = (word + 1) / 64; s < summary.size(); ++s) {
+            uint64_t mask = summary[s];
+            if (s == (word + 1) / 64)
+                mask &= ~0ULL << ((word + 1) % 64);
+            if (mask) {
+                size_t w2 = s * 64 + __builtin_ctzll(mask);
+                return w2 * 64 + __builtin_ctzll(words[w2]);
+            }
+        }
+        return -1;
+    }
+
+    // Maior folga não vazia, ou -1
+    int64_t largest() const {
+        for (size_t s = summary.size(); s-- > 0;) {
+            if (summary[s]) {
+                size_t w2 = s * 64 + 63 - __builtin_clzll(summary[s]);
+                return w2 * 64 + 63 - __builtin_clzll(words[w2]);
+            }
+        }
+        return -1;
+    }
+};
+
+// Regras de colocação para as heurísticas construtivas. Cada regra guarda o
+// estado das bins abertas e, em place(), devolve a bin que recebe o item,
+// abrindo uma nova (índice == número de bins abertas) quando necessário
+template <typename Size>
+struct FirstFitRule {
+    FirstFitTree<Size> tree;
+    size_t open = 0;
+    Size capacity = 0;
+
+    void reset(size_t n, Size c) {
+        tree.reset(n);
+        open = 0;
+        capacity = c;
+    }
+
+    size_t place(Size item) {
+        size_t bin = tree.first_fit(item, capacity);
+        if (bin >= open)
+            bin = open++;
+        tree.add(bin, item);
+        return bin;
+    }
+};
+
+// Best Fit: a bin com a menor folga em que o item ainda cabe
+template <typename Size>
+struct BestFitRule {
+    ResidualBuckets buckets;
+    size_t open = 0;
+    Size capacity = 0;
+
+    void reset(size_t n, Size c) {
+        buckets.reset(n, c);
+        open = 0;
+        capacity = c;
+    }
+
+    size_t place(Size item) {
+        int64_t r = buckets.at_least(item);
+        if (r < 0) {
+            buckets.insert(open, capacity - item);
+            return open++;
+        }
+
+        size_t bin = buckets.head[r];
+        buckets.erase(bin);
+        buckets.insert(bin, r - item);
+        return bin;
+    }
+};
+
+// Worst Fit: a bin com a maior folga, se o item couber nela
+template <typename Size>
+struct WorstFitRule {
+    ResidualBuckets buckets;
+    size_t open = 0;
+    Size capacity = 0;
+
+    void reset(size_t n, Size c) {
+        buckets.reset(n, c);
+        open = 0;
+        capacity = c;
+    }
+
+    size_t place(Size item) {
+        int64_t r = buckets.largest();
+        if (r < item) {
+            buckets.insert(open, capacity - item);
+            return open++;
+        }
+
+        size_t bin = buckets.head[r];
+        buckets.erase(bin);
+        buckets.insert(bin, r - item);
+        return bin;
+    }
+};
+
+// Empacotamento em formato CSR: os itens ficam agrupados por bin em items e
+// a bin i ocupa [offsets[i], offsets[i + 1]). Reaproveitar o mesmo Packing
+// entre chamadas evita alocações, já que os vetores só crescem
+template <typename Size>
+struct Packing {
+    std::vector<Size> items;
+    std::vector<uint32_t> offsets{0};
+    std::vector<uint32_t> bin_of;  // Área de trabalho de construct
+
+    size_t bins() const { return offsets.size() - 1; }
+    const Size* begin(size_t bin) const { return items.data() + offsets[bin]; }
+    const Size* end(size_t bin) const { return items.data() + offsets[bin + 1]; }
+};
+
+// Agrupa os itens pela bin indicada em packing.bin_of, com um counting sort
+// que mantém a ordem dos itens dentro de cada bin
+template <typename Size>
+void group_by_bin(const std::vector<Size>& items, size_t open, Packing<Size>& packing) {
+    auto& offsets = packing.offsets;
+    offsets.assign(open + 1, 0);
+    for (uint32_t bin : packing.bin_of)
+        ++offsets[bin + 1];
+    for (size_t bin = 0; bin < open; ++bin)
+        offsets[bin + 1] += offsets[bin];
+
+    // offsets[bin] avança até o início da bin seguinte e depois é deslocado
+    packing.items.resize(items.size());
+    for (size_t i = 0; i < items.size(); ++i)
+        packing.items[offsets[packing.bin_of[i]]++] = items[i];
+    for (size_t bin = open; bin > 0; --bin)
+        offsets[bin] = offsets[bin - 1];
+    offsets[0] = 0;
+}
+
+// Empacota os itens na ordem dada com a regra de colocação Rule e devolve o
+// número de bins
+template <typename Rule, typename Size>
+size_t construct(const std::vector<Size>& items, Size capacity, Packing<Size>& packing) {
+    static thread_local Rule rule;
+    rule.reset(items.size(), capacity);
+
+    size_t open = 0;
+    packing.bin_of.resize(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        size_t bin = rule.place(items[i]);
+        packing.bin_of[i] = bin;
+        open = std::max(open, bin + 1);
+    }
+
+    group_by_bin(items, open, packing);
+    return open;
+}
+
+template <typename Rule, typename Size>
+Packing<Size> construct(const std::vector<Size>& items, Size capacity) {
+    Packing<Size> packing;
+    construct<Rule>(items, capacity, packing);
+    return packing;
+}
+
+// Função de avaliação usando First Fit: só conta as bins, sem montar o
+// empacotamento
+template <typename Size>
+size_t fitness_first_fit(const std::vector<Size>& items, Size capacity) {
+    static thread_local FirstFitRule<Size> rule;
+    rule.reset(items.size(), capacity);
+    for (Size item : items)
+        rule.place(item);
+    return rule.open;
+}
+
+// Empacotamento completo do First Fit, usado só para imprimir a resposta
+template <typename Size>
+Packing<Size> pack_first_fit(const std::vector<Size>& items, Size capacity) {
+    return construct<FirstFitRule<Size>>(items, capacity);
+}
+
+// Itens agrupados por tamanho: os tamanhos distintos em ordem decrescente e
+// quantos itens há de cada um
+template <typename Size>
+struct ItemClasses {
+    std::vector<Size> sizes;
+    std::vector<uint32_t> counts;
+
+    // Conta com uma tabela hash e só ordena os tamanhos distintos
+    explicit ItemClasses(const std::vector<Size>& items) {
+        std::unordered_map<Size, uint32_t> count;
+        for (Size item : items)
+            ++count[item];
+
+        for (const auto& entry : count)
+            sizes.push_back(entry.first);
+        std::sort(sizes.begin(), sizes.end(), std::greater<Size>());
+        for (Size size : sizes)
+            counts.push_back(count[size]);
+    }
+
+    size_t distinct() const { return sizes.size(); }
+
+    // Classe do tamanho, que precisa estar em sizes
+    size_t index_of(Size size) const {
+        return std::lower_bound(sizes.begin(), sizes.end(), size, std::greater<Size>()) - sizes.begin();
+    }
+};
+
+// First Fit Decreasing sobre os pares (tamanho, quantidade): as cópias de um
+// tamanho vão em bloco para a primeira bin em que cabem, quantas couberem.
+// Dá o mesmo empacotamento do FFD item a item, pois a cópia seguinte não cabe
+// em nenhuma bin anterior à que recebeu a atual, em O(distintos x bins tocadas)
+template <typename Size>
+Packing<Size> first_fit_decreasing(const ItemClasses<Size>& classes, Size capacity) {
+    struct Placement {
+        uint32_t bin, cls, copies;
+    };
+    std::vector<Placement> placements;
+
+    size_t n = 0;
+    for (uint32_t count : classes.counts)
+        n += count;
+
+    FirstFitTree<Size> tree;
+    tree.reset(n);
+    size_t open = 0;
+    for (size_t c = 0; c < classes.distinct(); ++c) {
+        Size size = classes.sizes[c];
+        for (uint32_t left = classes.counts[c]; left > 0;) {
+            size_t bin = tree.first_fit(size, capacity);
+            if (bin >= open)
+                bin = open++;
+            // Um item maior que a capacidade fica sozinho numa bin nova, e os
+            // de tamanho zero cabem todos na primeira bin que os aceita
+            Size room = capacity - tree.load_of(bin);
+            uint32_t copies = size > room ? 1 : size == 0 ? left : uint32_t(std::min<int64_t>(left, room / size));
+            tree.add(bin, size * copies);
+            placements.push_back({uint32_t(bin), uint32_t(c), copies});
+            left -= copies;
+        }
+    }
+
+    // Mesmo counting sort de construct, agora por bloco de cópias
+    Packing<Size> packing;
+    packing.offsets.assign(open + 1, 0);
+    for (const Placement& p : placements)
+        packing.offsets[p.bin + 1] += p.copies;
+    for (size_t bin = 0; bin < open; ++bin)
+        packing.offsets[bin + 1] += packing.offsets[bin];
+
+    packing.items.resize(n);
+    std::vector<uint32_t> fill(packing.offsets.begin(), packing.offsets.end() - 1);
+    for (const Placement& p : placements) {
+        std::fill_n(packing.items.begin() + fill[p.bin], p.copies, classes.sizes[p.cls]);
+        fill[p.bin] += p.copies;
+    }
+    return packing;
+}
+
+// Executa uma das heurísticas construtivas de HEURISTICS
+template <typename Size>
+Packing<Size> run_heuristic(const std::string& name, std::vector<Size> items, Size capacity) {
+    if (name == "ffd")
+        return first_fit_decreasing(ItemClasses<Size>(items), capacity);
+    if (name.back() == 'd')
+        std::sort(items.begin(), items.end(), std::greater<Size>());
+
+    if (name.compare(0, 2, "bf") == 0)
+        return construct<BestFitRule<Size>>(items, capacity);
+    if (name.compare(0, 2, "wf") == 0)
+        return construct<WorstFitRule<Size>>(items, capacity);
+    return construct<FirstFitRule<Size>>(items, capacity);
+}
+
+// Avaliação incremental de trocas para o First Fit. Guarda as cargas das
+// bins a cada `stride` posições da permutação aceita; uma troca (a, b) é
+// avaliada no lugar, refazendo o First Fit a partir do checkpoint anterior a
+// min(a, b) e parando assim que o estado volta a coincidir com o da
+// permutação aceita, já que a partir daí o empacotamento é o mesmo
+template <typename Size, typename Index = FirstFitTree<Size>>
+class SwapEvaluator {
+public:
+    static constexpr size_t CHECKPOINTS = 32;
+
+    SwapEvaluator(std::vector<Size> items, Size capacity)
+        : order_(std::move(items)), capacity_(capacity) {
+        stride_ = std::max<size_t>(1, (order_.size() + CHECKPOINTS - 1) / CHECKPOINTS);
+        tree_.reset(order_.size());
+        shadow_.resize(order_.size());
+        stamp_.resize(order_.size(), 0);
+        differs_.resize(order_.size(), 0);
+        rebuild();
+    }
+
+    int bins() const { return bins_; }
+    const std::vector<Size>& order() const { return order_; }
+
+    // Troca as posições a e b e retorna o número de bins resultante
+    int try_swap(size_t a, size_t b) {
+        std::swap(order_[a], order_[b]);
+        swap_a_ = a;
+        swap_b_ = b;
+        if (order_[a] == order_[b])
+            return bins_;
+
+        size_t first = std::min(a, b), last = std::max(a, b);
+        Snapshot snapshot = checkpoint(first / stride_);
+        size_t open = snapshot.size, accepted_open = open;
+        tree_.restore(snapshot.loads, snapshot.size, dirty_);
+        dirty_ = open;
+
+        ++epoch_;
+        mismatches_ = 0;
+        for (size_t q = first / stride_ * stride_; q < order_.size(); ++q) {
+            if (q > last && mismatches_ == 0 && open == accepted_open)
+                return bins_;
+
+            Size item = order_[q];
+            size_t bin = tree_.first_fit(item, capacity_);
+            if (bin >= open)
+                bin = open++;
+            tree_.add(bin, item);
+            dirty_ = std::max(dirty_, open);
+            track(bin, snapshot);
+
+            // Mesmo passo na permutação aceita
+            Size accepted = q == a ? order_[b] : q == b ? order_[a] : item;
+            size_t accepted_bin = bin_of_[q];
+            shadow_[accepted_bin] = shadow(accepted_bin, snapshot) + accepted;
+            stamp_[accepted_bin] = epoch_;
+            accepted_open = std::max(accepted_open, accepted_bin + 1);
+            track(accepted_bin, snapshot);
+        }
+
+        return open;
+    }
+
+    // Mantém a última troca avaliada
+    void accept() { rebuild(); }
+
+    // Desfaz a última troca avaliada
+    void reject() { std::swap(order_[swap_a_], order_[swap_b_]); }
+
+private:
+    std::vector<Size> order_;
+    Size capacity_;
+    size_t stride_ = 1;
+    int bins_ = 0;
+
+    Index tree_;
+    size_t dirty_ = 0;
+    std::vector<uint32_t> bin_of_;
+    // Checkpoints guardados em sequência num único vetor, sem alocar a cada
+    // aceitação: o checkpoint c ocupa [checkpoint_begin_[c], checkpoint_begin_[c + 1])
+    std::vector<Size> checkpoint_loads_;
+    std::vector<size_t> checkpoint_begin_;
+    size_t swap_a_ = 0, swap_b_ = 0;
+
+    // Cargas da permutação aceita no mesmo ponto da reavaliação; entradas com
+    // stamp_ diferente de epoch_ ainda valem o checkpoint de partida
+    std::vector<Size> shadow_;
+    std::vector<uint64_t> stamp_;
+    std::vector<uint64_t> differs_;  // == epoch_ se a carga da bin difere
+    uint64_t epoch_ = 0;
+    size_t mismatches_ = 0;
+
+    struct Snapshot {
+        const Size* loads;
+        size_t size;
+    };
+
+    Snapshot checkpoint(size_t c) const {
+        size_t begin = checkpoint_begin_[c];
+        return {checkpoint_loads_.data() + begin, checkpoint_begin_[c + 1] - begin};
+    }
+
+    Size shadow(size_t bin, const Snapshot& snapshot) const {
+        if (stamp_[bin] == epoch_)
+            return shadow_[bin];
+        return bin < snapshot.size ? snapshot.loads[bin] : 0;
+    }
+
+    // Atualiza a contagem de bins cuja carga difere da permutação aceita
+    void track(size_t bin, const Snapshot& snapshot) {
+        bool differs = tree_.load_of(bin) != shadow(bin, snapshot);
+        if (differs == (differs_[bin] == epoch_))
+            return;
+
+        differs_[bin] = differs ? epoch_ : 0;
+        if (differs)
+            ++mismatches_;
+        else
+            --mismatches_;
+    }
+
+    // Empacota a permutação inteira, registrando a bin de cada posição e os
+    // checkpoints
+    void rebuild() {
+        bin_of_.resize(order_.size());
+        checkpoint_loads_.clear();
+        checkpoint_begin_.assign(1, 0);
+        tree_.restore(checkpoint_loads_.data(), 0, dirty_);
+
+        size_t open = 0;
+        for (size_t q = 0; q < order_.size(); ++q) {
+            if (q % stride_ == 0) {
+                checkpoint_loads_.insert(checkpoint_loads_.end(), tree_.loads(), tree_.loads() + open);
+                checkpoint_begin_.push_back(checkpoint_loads_.size());
+            }
+
+            size_t bin = tree_.first_fit(order_[q], capacity_);
+            if (bin >= open)
+                bin = open++;
+            tree_.add(bin, order_[q]);
+            bin_of_[q] = bin;
+        }
+
+        dirty_ = open;
+        bins_ = open;
+    }
+};
+
+// Gerador xorshift64* de cada worker, bem mais barato que um mt19937
+// compartilhado
+struct Rng {
+    uint64_t state;
+
+    explicit Rng(uint64_t seed) : state(seed * 0x9e3779b97f4a7c15ULL | 1) {}
+
+    uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545f4914f6cdd1dULL;
+    }
+};
+
+// Gera índice aleatório para troca
+inline size_t gen_random_index(Rng& rng, size_t size) {
+    return ((rng.next() >> 32) * size) >> 32;
+}
+
+// Retorna uma permutação aleatória dos itens
+template <typename Size>
+std::vector<Size> permute(const std::vector<Size>& initial, uint64_t seed) {
+    auto permutation = initial;
+    std::mt19937_64 gen(seed);
+    std::shuffle(permutation.begin(), permutation.end(), gen);
+    return permutation;
+}
+
+// Sorteia as trocas da busca local sem nunca propor duas posições com o mesmo
+// tamanho, que não mudam o empacotamento. As posições ficam agrupadas por
+// classe de tamanho; a primeira é sorteada entre todas e a segunda entre as
+// de fora da classe da primeira, em O(1)
+template <typename Size>
+class SwapSampler {
+public:
+    SwapSampler(const std::vector<Size>& order, const ItemClasses<Size>& classes) {
+        size_t n = order.size(), k = classes.distinct();
+        class_at_.resize(n);
+        begin_.assign(k + 1, 0);
+        for (size_t q = 0; q < n; ++q) {
+            class_at_[q] = classes.index_of(order[q]);
+            ++begin_[class_at_[q] + 1];
+        }
+        for (size_t c = 0; c < k; ++c)
+            begin_[c + 1] += begin_[c];
+
+        std::vector<uint32_t> fill(begin_.begin(), begin_.end() - 1);
+        by_class_.resize(n);
+        where_.resize(n);
+        for (size_t q = 0; q < n; ++q) {
+            where_[q] = fill[class_at_[q]]++;
+            by_class_[where_[q]] = q;
+        }
+    }
+
+    // Falso se todos os itens têm o mesmo tamanho e não há troca útil
+    bool movable() const { return begin_.size() > 2; }
+
+    void sample(Rng& rng, size_t& a, size_t& b) const {
+        size_t n = by_class_.size();
+        a = gen_random_index(rng, n);
+        uint32_t c = class_at_[a];
+        size_t count = begin_[c + 1] - begin_[c];
+        size_t r = gen_random_index(rng, n - count);
+        if (r >= begin_[c])
+            r += count;
+        b = by_class_[r];
+    }
+
+    // Registra a troca aceita das posições a e b
+    void swapped(size_t a, size_t b) {
+        std::swap(class_at_[a], class_at_[b]);
+        by_class_[where_[a]] = b;
+        by_class_[where_[b]] = a;
+        std::swap(where_[a], where_[b]);
+    }
+
+private:
+    std::vector<uint32_t> class_at_;  // Classe do item em cada posição
+    std::vector<uint32_t> begin_;     // Posições da classe c: by_class_[begin_[c], begin_[c + 1])
+    std::vector<uint32_t> by_class_;
+    std::vector<uint32_t> where_;     // Índice de cada posição em by_class_
+};
+
+// Cópia da melhor solução encontrada pelos workers (SearchState::snapshot)
+template <typename Size>
+struct Incumbent {
+    int bins = -1;
+    std::vector<Size> order;
+    double seconds = 0;  // Desde o início da busca
+};
+
+// Estado compartilhado entre os workers de uma execução
+template <typename Size>
+struct SearchState {
+    std::atomic<bool> stop_execution{false};
+    int64_t lower_bound = 0;  // Calculado uma vez, antes dos workers
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point deadline;  // Os workers param sozinhos ao atingi-lo
+
+    bool expired() const { return std::chrono::steady_clock::now() >= deadline; }
+
+    // Telemetria: os workers somam os contadores em blocos, com operações
+    // relaxed, e cada nova incumbente entra na trajetória (são raras)
+    std::atomic<uint64_t> evaluations{0};  // Movimentos avaliados por todos os workers
+    std::atomic<uint64_t> accepted{0};     // Movimentos aceitos
+    std::mutex trace_mutex;
+    std::vector<std::pair<double, int>> trace;  // (segundos, bins) de cada melhora
+
+    void count(uint64_t evaluated, uint64_t taken) {
+        evaluations.fetch_add(evaluated, std::memory_order_relaxed);
+        if (taken)
+            accepted.fetch_add(taken, std::memory_order_relaxed);
+    }
+
+    // Incumbente num seqlock. best_bins é lido sem trava pelos workers, que
+    // descartam de imediato o que não melhora. Quem publica torna sequence
+    // ímpar com um CAS (o que também exclui os outros escritores), copia a
+    // ordem para o slot e a torna par; o leitor repete a cópia se sequence
+    // estava ímpar ou mudou no meio. O slot guarda atômicos lidos e escritos
+    // com memory_order_relaxed, para que a leitura concorrente não seja data
+    // race, e é alocado uma única vez, em reserve
+    std::atomic<int> best_bins{std::numeric_limits<int>::max()};
+    std::atomic<double> best_seconds{0};
+    std::atomic<uint64_t> sequence{0};
+    std::unique_ptr<std::atomic<Size>[]> slot;
+    size_t slot_size = 0;
+
+    void reserve(size_t n) {
+        slot.reset(new std::atomic<Size>[n]);
+        slot_size = n;
+    }
+
+    bool has_incumbent() const { return best_bins.load(std::memory_order_relaxed) != std::numeric_limits<int>::max(); }
+
+    // Publica a solução se ela usar menos bins que a incumbente atual
+    void publish(int bins, const std::vector<Size>& order) {
+        uint64_t seq = sequence.load(std::memory_order_relaxed);
+        for (;;) {
+            if (bins >= best_bins.load(std::memory_order_relaxed))
+                return;
+            if (seq % 2 == 0 &&
+                sequence.compare_exchange_weak(seq, seq + 1, std::memory_order_relaxed, std::memory_order_relaxed))
+                break;
+            if (seq % 2)
+                std::this_thread::yield();
+            seq = sequence.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+
+        // Outro escritor pode ter publicado algo melhor antes do CAS
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        bool improved = bins < best_bins.load(std::memory_order_relaxed);
+        if (improved) {
+            best_bins.store(bins, std::memory_order_relaxed);
+            best_seconds.store(seconds, std::memory_order_relaxed);
+            for (size_t i = 0; i < slot_size; ++i)
+                slot[i].store(order[i], std::memory_order_relaxed);
+        }
+        sequence.store(seq + 2, std::memory_order_release);
+
+        if (improved) {
+            std::lock_guard<std::mutex> lock(trace_mutex);
+            trace.emplace_back(seconds, bins);
+        }
+    }
+
+    // Copia a incumbente para out e retorna a versão (sequence) copiada
+    uint64_t snapshot(Incumbent<Size>& out) const {
+        out.order.resize(slot_size);
+        for (;;) {
+            uint64_t seq = sequence.load(std::memory_order_acquire);
+            if (seq % 2) {
+                std::this_thread::yield();
+                continue;
+            }
+            out.bins = best_bins.load(std::memory_order_relaxed);
+            out.seconds = best_seconds.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < slot_size; ++i)
+                out.order[i] = slot[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == seq)
+                return seq;
+        }
+    }
+};
+
+// Algoritmo de busca local usando permutação de pares; Index é a estrutura
+// de busca do First Fit usada pelo avaliador (árvore ou varredura)
+template <typename Size, typename Index>
+std::vector<Size> bin_packing_ff(SearchState<Size>& state, std::vector<Size> items, Size capacity, uint64_t seed) {
+    Rng rng(seed);
+    ItemClasses<Size> classes(items);
+    SwapSampler<Size> sampler(items, classes);
+    int n = items.size();
+    SwapEvaluator<Size, Index> evaluator(std::move(items), capacity);
+    int best_fitness = evaluator.bins();
+    state.publish(best_fitness, evaluator.order());
+
+    // Com um só tamanho toda permutação dá o mesmo empacotamento
+    while (sampler.movable() && !state.stop_execution && !state.expired()) {
+        // Incumbente comprovadamente ótima: encerra todos os workers
+        if (best_fitness <= state.lower_bound) {
+            state.stop_execution = true;
+            break;
+        }
+
+        int k = std::min(100, n);
+        int accepted = 0;
+
+        for (int i = 0; i < k; ++i) {
+            size_t a, b;
+            sampler.sample(rng, a, b);
+
+            // Vizinho avaliado no lugar: mantém a troca só se melhorar
+            int fit = evaluator.try_swap(a, b);
+            if (fit < best_fitness) {
+                evaluator.accept();
+                sampler.swapped(a, b);
+                state.publish(fit, evaluator.order());
+                best_fitness = fit;
+                ++accepted;
+            } else {
+                evaluator.reject();
+            }
+        }
+        state.count(k, accepted);
+    }
+
+    // Nenhuma troca muda o empacotamento: a busca se esgotou antes do prazo
+    if (!sampler.movable())
+        state.stop_execution = true;
+
+    return evaluator.order();
+}
+
+// Annealing sobre as bins: em vez de permutar e reempacotar, move itens
+// diretamente entre duas bins. Os movimentos são deslocar um item e trocar
+// 1-1, 1-2/2-1 e 2-2 itens, sempre viáveis; a bin de origem é a mais vazia de
+// duas sorteadas, para que os movimentos tendam a esvaziá-la. O objetivo é a
+// soma dos quadrados das cargas (normalizadas pela capacidade), que recompensa
+// bins cheias e, ao contrário do número de bins, muda a cada movimento.
+// A temperatura cai geometricamente de SA_T0 a SA_T1 até o tempo limite
+inline const double SA_T0 = 0.02, SA_T1 = 0.0002;
+
+template <typename Size>
+class BinAnnealing {
+public:
+    BinAnnealing(const std::vector<Size>& order, Size capacity) : capacity_(capacity) {
+        Packing<Size> packing = pack_first_fit(order, capacity);
+        bins_.resize(packing.bins());
+        load_.resize(packing.bins());
+        for (size_t b = 0; b < packing.bins(); ++b) {
+            bins_[b].assign(packing.begin(b), packing.end(b));
+            load_[b] = std::accumulate(packing.begin(b), packing.end(b), Size(0));
+        }
+    }
+
+    size_t bins() const { return bins_.size(); }
+
+    // Itens bin a bin: o First Fit nessa ordem usa no máximo bins() bins
+    std::vector<Size> order() const {
+        std::vector<Size> order;
+        for (const auto& bin : bins_)
+            order.insert(order.end(), bin.begin(), bin.end());
+        return order;
+    }
+
+    // Tenta um movimento aleatório à temperatura t; retorna true se aceito
+    bool step(Rng& rng, double t) {
+        size_t m = bins_.size();
+        if (m < 2)
+            return false;
+
+        size_t a = gen_random_index(rng, m), b = gen_random_index(rng, m);
+        if (a == b)
+            return false;
+        if (load_[b] < load_[a])
+            std::swap(a, b);  // a é a mais vazia
+
+        // Quantos itens saem de a e de b: 1-0, 1-1, 1-2, 2-1 ou 2-2
+        static const int MOVES[5][2] = {{1, 0}, {1, 1}, {1, 2}, {2, 1}, {2, 2}};
+        const int* move = MOVES[gen_random_index(rng, 5)];
+        if (bins_[a].size() < size_t(move[0]) || bins_[b].size() < size_t(move[1]))
+            return false;
+
+        size_t ia[2], ib[2];
+        Size out_a = pick(rng, bins_[a], move[0], ia), out_b = pick(rng, bins_[b], move[1], ib);
+        Size new_a = load_[a] - out_a + out_b, new_b = load_[b] - out_b + out_a;
+        if (new_a > capacity_ || new_b > capacity_ || out_a == out_b)
+            return false;
+
+        double delta = square(new_a) + square(new_b) - square(load_[a]) - square(load_[b]);
+        if (delta < 0 && std::exp(delta / t) * 4294967296.0 < double(rng.next() >> 32))
+            return false;
+
+        Size moved_a[2], moved_b[2];
+        take(bins_[a], move[0], ia, moved_a);
+        take(bins_[b], move[1], ib, moved_b);
+        bins_[a].insert(bins_[a].end(), moved_b, moved_b + move[1]);
+        bins_[b].insert(bins_[b].end(), moved_a, moved_a + move[0]);
+        load_[a] = new_a;
+        load_[b] = new_b;
+
+        if (bins_[a].empty()) {
+            std::swap(bins_[a], bins_.back());
+            std::swap(load_[a], load_.back());
+            bins_.pop_back();
+            load_.pop_back();
+        }
+        return true;
+    }
+
+private:
+    Size capacity_;
+    std::vector<std::vector<Size>> bins_;
+    std::vector<Size> load_;
+
+    double square(Size load) const {
+        double fill = double(load) / capacity_;
+        return fill * fill;
+    }
+
+    // Sorteia k posições distintas da bin e devolve a soma dos itens
+    static Size pick(Rng& rng, const std::vector<Size>& bin, int k, size_t* index) {
+        Size sum = 0;
+        for (int i = 0; i < k; ++i) {
+            do {
+                index[i] = gen_random_index(rng, bin.size());
+            } while (i == 1 && index[1] == index[0]);
+            sum += bin[index[i]];
+        }
+        return sum;
+    }
+
+    // Remove da bin os itens das posições sorteadas, copiando-os para taken
+    static void take(std::vector<Size>& bin, int k, size_t* index, Size* taken) {
+        if (k == 2 && index[0] < index[1])
+            std::swap(index[0], index[1]);  // Remove a maior posição primeiro
+        for (int i = 0; i < k; ++i) {
+            taken[i] = bin[index[i]];
+            bin[index[i]] = bin.back();
+            bin.pop_back();
+        }
+    }
+};
+
+// Worker do annealing sobre as bins, com a mesma interface de bin_packing_ff
+template <typename Size>
+std::vector<Size> bin_packing_sa(SearchState<Size>& state, std::vector<Size> items, Size capacity, uint64_t seed) {
+    Rng rng(seed);
+    BinAnnealing<Size> annealing(items, capacity);
+    size_t best_bins = annealing.bins();
+    state.publish(best_bins, annealing.order());
+
+    using Clock = std::chrono::steady_clock;
+    double total = std::chrono::duration<double>(state.deadline - state.start).count();
+    double t = SA_T0;
+
+    while (!state.stop_execution) {
+        if (int64_t(best_bins) <= state.lower_bound) {
+            state.stop_execution = true;
+            break;
+        }
+
+        // Temperatura pela fração do tempo já usada, recalculada a cada bloco
+        auto now = Clock::now();
+        if (now >= state.deadline)
+            break;
+        double elapsed = std::chrono::duration<double>(now - state.start).count();
+        t = SA_T0 * std::pow(SA_T1 / SA_T0, std::min(1.0, elapsed / std::max(total, 1e-9)));
+
+        int accepted = 0;
+        for (int i = 0; i < 1024; ++i)
+            accepted += annealing.step(rng, t);
+        state.count(1024, accepted);
+
+        if (annealing.bins() < best_bins) {
+            best_bins = annealing.bins();
+            state.publish(best_bins, annealing.order());
+        }
+    }
+
+    return annealing.order();
+}
+
+// Estrutura de busca do First Fit no avaliador da busca local. Auto usa a
+// varredura quando o limitante inferior indica poucas bins
+enum class EvaluatorKind { Auto, Tree, Scan };
+
+// Até quantas bins a varredura supera a árvore em cada nível SIMD: mediana
+// da linha "cruzam." de cinco execuções de "bench-first-fit 40" num Xeon
+// com AVX-512 e um núcleo (o escalar e o AVX2 medidos na mesma máquina).
+// Perto do cruzamento as duas empatam, e em outra máquina os valores podem
+// mudar em até um terço; basta rodar o bench de novo
+inline int64_t scan_max_bins() {
+    switch (simd_level) {
+    case SimdLevel::Avx512:
+        return 3100;
+    case SimdLevel::Avx2:
+        return 1250;
+    default:
+        return 150;
+    }
+}
+
+struct SearchOptions {
+    int time_limit = 0;     // segundos
+    int budget_ms = 0;      // se positivo, substitui time_limit (orçamento por instância no modo lote)
+    int threads = 1;
+    std::string heuristic;  // vazio: testa todas as de HEURISTICS
+    EvaluatorKind evaluator = EvaluatorKind::Auto;
+    bool annealing = false; // true: annealing sobre as bins em vez das permutações
+    uint64_t seed = 0;      // 0: semente aleatória; fixa, a busca de cada worker é reproduzível
+
+    // Telemetria e checkpoint, desligados com o caminho vazio
+    std::string telemetry;          // JSON gravado com SIGUSR1 e ao terminar
+    std::string checkpoint;         // incumbente no formato binário de instância
+    int checkpoint_interval = 60;   // segundos
+    uint32_t checkpoint_scale = 1;  // escala dos tamanhos em ponto fixo (1: inteiros)
+
+    std::chrono::milliseconds time_budget() const {
+        return std::chrono::milliseconds(budget_ms > 0 ? int64_t(budget_ms) : 1000 * int64_t(time_limit));
+    }
+};
+
+template <typename Size>
+struct SearchResult {
+    Packing<Size> packing;
+    bool finished;          // true se a busca parou antes do tempo limite
+    bool optimal;           // true se a solução é comprovadamente ótima
+    std::string heuristic;  // heurística da solução inicial, se houver
+    size_t heuristic_bins;
+    LowerBounds bounds;
+    size_t distinct_sizes;  // a busca só troca itens de tamanhos diferentes
+    uint64_t evaluations;   // trocas avaliadas pela busca local
+    double seconds;         // duração da busca
+    double best_seconds;    // quando a solução final foi encontrada
+    std::vector<std::pair<double, int>> trace;  // (segundos, bins) de cada melhora da incumbente
+};
+
+// Permutação inicial dada pela melhor das heurísticas pedidas (as que não se
+// aplicam à capacidade são ignoradas); vazia se nenhuma foi executada
+template <typename Size>
+std::vector<Size> best_heuristic(const std::vector<Size>& items, Size capacity, const SearchOptions& options,
+                                 SearchResult<Size>& result) {
+    std::vector<Size> initial;
+    for (const std::string& name : HEURISTICS) {
+        if (!options.heuristic.empty() && name != options.heuristic)
+            continue;
+        if (name[0] != 'f' && capacity > MAX_BUCKET_CAPACITY)
+            continue;
+
+        // Os itens em ordem de bin formam a permutação inicial
+        std::vector<Size> order = run_heuristic(name, items, capacity).items;
+        size_t used = fitness_first_fit(order, capacity);
+        if (initial.empty() || used < result.heuristic_bins) {
+            initial = order;
+            result.heuristic = name;
+            result.heuristic_bins = used;
+        }
+    }
+    return initial;
+}
+
+// Um checkpoint só pode ser retomado sobre a mesma instância: mesma
+// capacidade e os mesmos itens, em qualquer ordem
+template <typename Size>
+bool same_instance(const std::vector<Size>& items, Size capacity, const Instance<Size>& saved) {
+    if (saved.capacity != capacity || saved.items.size() != items.size())
+        return false;
+    std::vector<Size> a = items, b = saved.items;
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    return a == b;
+}
+
+// Pedido de despejo da telemetria, marcado pelo tratador de SIGUSR1
+inline volatile std::sig_atomic_t telemetry_requested = 0;
+
+inline void request_telemetry(int) { telemetry_requested = 1; }
+
+// Grava em path um JSON com os contadores e a trajetória da busca. O arquivo
+// é escrito ao lado e renomeado, para nunca ser lido pela metade
+template <typename Size>
+void write_telemetry(SearchState<Size>& state, const std::string& path, int threads) {
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - state.start).count();
+    uint64_t evaluations = state.evaluations.load(std::memory_order_relaxed);
+    int best = state.has_incumbent() ? state.best_bins.load(std::memory_order_relaxed) : -1;
+
+    std::string temp = path + ".tmp";
+    FILE* out = std::fopen(temp.c_str(), "w");
+    if (!out)
+        return;
+
+    std::fprintf(out, "{\n  \"tempo_s\": %.3f,\n  \"avaliacoes\": %llu,\n  \"aceitos\": %llu,\n", seconds,
+                 (unsigned long long)evaluations, (unsigned long long)state.accepted.load(std::memory_order_relaxed));
+    std::fprintf(out, "  \"ns_por_avaliacao\": %.1f,\n", evaluations ? 1e9 * seconds * threads / evaluations : 0.0);
+    std::fprintf(out, "  \"melhor_bins\": %d,\n  \"limitante\": %lld,\n", best,
+                 (long long)state.lower_bound);
+    std::fprintf(out, "  \"parado\": %s,\n  \"trajetoria\": [", state.stop_execution ? "true" : "false");
+    {
+        std::lock_guard<std::mutex> lock(state.trace_mutex);
+        for (size_t i = 0; i < state.trace.size(); ++i)
+            std::fprintf(out, "%s{\"t\": %.6f, \"bins\": %d}", i ? ", " : "", state.trace[i].first,
+                         state.trace[i].second);
+    }
+    std::fprintf(out, "]\n}\n");
+
+    if (std::fclose(out) == 0)
+        std::rename(temp.c_str(), path.c_str());
+}
+
+// Grava a ordem da incumbente como instância binária: retomar a busca a
+// partir dela reproduz a incumbente com o First Fit
+template <typename Size>
+void write_checkpoint(const Incumbent<Size>& best, Size capacity, const SearchOptions& options) {
+    Instance<Size> instance{capacity, best.order};
+    ItemType type = std::is_same<Size, int64_t>::value ? ItemType::Int64 : ItemType::Fixed32;
+    std::string temp = options.checkpoint + ".tmp";
+    try {
+        write_binary(temp, instance, type, options.checkpoint_scale);
+        std::rename(temp.c_str(), options.checkpoint.c_str());
+    } catch (const std::exception&) {
+        // Um checkpoint perdido não deve interromper a busca
+    }
+}
+
+// Thread de acompanhamento, só criada com telemetria ou checkpoint: atende
+// SIGUSR1, grava o checkpoint a cada intervalo se a incumbente mudou e faz o
+// último despejo quando a busca para
+template <typename Size>
+void monitor_search(SearchState<Size>& state, Size capacity, const SearchOptions& options) {
+    using Clock = std::chrono::steady_clock;
+    auto next_checkpoint = Clock::now() + std::chrono::seconds(options.checkpoint_interval);
+    Incumbent<Size> best;
+    uint64_t saved = 0;  // Versão da incumbente no último checkpoint
+
+    auto save = [&]() {
+        if (options.checkpoint.empty() || state.sequence.load(std::memory_order_acquire) == saved)
+            return;
+        saved = state.snapshot(best);
+        write_checkpoint(best, capacity, options);
+    };
+
+    while (!state.stop_execution) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        if (telemetry_requested && !options.telemetry.empty()) {
+            telemetry_requested = 0;
+            write_telemetry(state, options.telemetry, options.threads);
+        }
+        if (Clock::now() >= next_checkpoint) {
+            save();
+            next_checkpoint = Clock::now() + std::chrono::seconds(options.checkpoint_interval);
+        }
+    }
+
+    save();
+    if (!options.telemetry.empty())
+        write_telemetry(state, options.telemetry, options.threads);
+}
+
+// Primeira etapa da busca: limitantes e solução inicial pela heurística
+// escolhida, já publicada como incumbente. resume, se dado, é a ordem de um
+// checkpoint e vira a solução inicial quando não é pior que a heurística.
+// Retorna a permutação inicial do primeiro worker
+template <typename Size>
+std::vector<Size> prepare_search(const std::vector<Size>& items, Size capacity, const SearchOptions& options,
+                                 const std::vector<Size>& resume, SearchState<Size>& state,
+                                 SearchResult<Size>& result, uint64_t seed) {
+    result.bounds = lower_bounds(std::vector<int64_t>(items.begin(), items.end()), capacity);
+    state.lower_bound = result.bounds.best();
+    result.distinct_sizes = ItemClasses<Size>(items).distinct();
+
+    std::vector<Size> initial = best_heuristic(items, capacity, options, result);
+    if (!resume.empty()) {
+        size_t used = fitness_first_fit(resume, capacity);
+        if (initial.empty() || used <= result.heuristic_bins) {
+            initial = resume;
+            result.heuristic = "checkpoint";
+            result.heuristic_bins = used;
+        }
+    }
+    if (initial.empty())
+        initial = permute(items, seed);
+    state.reserve(items.size());
+    state.publish(fitness_first_fit(initial, capacity), initial);
+
+    // Cada nova entrada da trajetória tem menos bins e nenhuma fica abaixo do
+    // limitante: com a reserva, publish nunca aloca durante a busca
+    state.trace.reserve(std::max<int64_t>(0, state.best_bins - state.lower_bound) + 1);
+    state.deadline = state.start + options.time_budget();
+    return initial;
+}
+
+// Worker da busca local pedido nas opções
+template <typename Size>
+auto search_worker(const SearchOptions& options, const SearchState<Size>& state) {
+    bool scan = options.evaluator == EvaluatorKind::Scan ||
+                (options.evaluator == EvaluatorKind::Auto && state.lower_bound <= scan_max_bins());
+    auto worker_fn = scan ? bin_packing_ff<Size, FirstFitScan<Size>> : bin_packing_ff<Size, FirstFitTree<Size>>;
+    if (options.annealing)
+        worker_fn = bin_packing_sa<Size>;
+    return worker_fn;
+}
+
+// Última etapa: empacota a incumbente e preenche o resultado
+template <typename Size>
+void finish_search(SearchState<Size>& state, Size capacity, SearchResult<Size>& result) {
+    Incumbent<Size> best;
+    state.snapshot(best);
+    result.packing = pack_first_fit(best.order, capacity);
+    result.evaluations = state.evaluations;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - state.start).count();
+    result.best_seconds = best.seconds;
+    {
+        std::lock_guard<std::mutex> lock(state.trace_mutex);
+        result.trace = state.trace;
+    }
+    result.optimal = int64_t(result.packing.bins()) <= state.lower_bound;
+}
+
+// Executa a busca completa: limitantes, solução inicial e os workers da
+// busca local até o tempo limite ou até provar a otimalidade. Se a solução
+// inicial já atinge o limitante, nenhum worker é lançado
+template <typename Size>
+SearchResult<Size> solve(const std::vector<Size>& items, Size capacity, const SearchOptions& options,
+                         const std::vector<Size>& resume = {}) {
+    SearchResult<Size> result{};
+    SearchState<Size> state;
+    uint64_t seed = options.seed ? options.seed : std::random_device()();
+    std::vector<Size> initial = prepare_search(items, capacity, options, resume, state, result, seed);
+    auto worker_fn = search_worker(options, state);
+
+    // Lança os workers da busca local em paralelo, cada um com sua própria
+    // permutação inicial e semente; o primeiro parte da heurística
+    std::vector<std::future<std::vector<Size>>> workers;
+    if (state.best_bins.load(std::memory_order_relaxed) > state.lower_bound) {
+        workers.push_back(std::async(std::launch::async, worker_fn, std::ref(state), initial, capacity, seed));
+        for (int t = 1; t < options.threads; ++t)
+            workers.push_back(std::async(std::launch::async, worker_fn, std::ref(state), permute(items, seed + t), capacity, seed + t));
+    }
+
+    std::thread monitor;
+    if (!options.telemetry.empty() || !options.checkpoint.empty()) {
+        if (!options.telemetry.empty())
+            std::signal(SIGUSR1, request_telemetry);
+        monitor = std::thread(monitor_search<Size>, std::ref(state), capacity, std::cref(options));
+    }
+
+    // Os workers param sozinhos no prazo; só um worker que parou antes dele
+    // (limitante atingido ou busca esgotada) marca stop_execution
+    for (auto& worker : workers)
+        worker.get();
+    bool stopped = state.stop_execution;
+
+    state.stop_execution = true;
+    if (monitor.joinable())
+        monitor.join();
+
+    finish_search(state, capacity, result);
+    result.finished = result.optimal || stopped;
+    return result;
+}
+
+// Mesma busca com um único worker executado na própria thread, sem criar
+// nenhuma: é a unidade de trabalho do modo lote, que já ocupa os núcleos
+// com instâncias diferentes. O worker para sozinho no prazo ou no limitante
+template <typename Size>
+SearchResult<Size> solve_inline(const std::vector<Size>& items, Size capacity, const SearchOptions& options) {
+    SearchResult<Size> result{};
+    SearchState<Size> state;
+    uint64_t seed = options.seed ? options.seed : std::random_device()();
+    std::vector<Size> initial = prepare_search(items, capacity, options, {}, state, result, seed);
+
+    if (state.best_bins.load(std::memory_order_relaxed) > state.lower_bound)
+        search_worker(options, state)(state, std::move(initial), capacity, seed);
+
+    finish_search(state, capacity, result);
+    result.finished = result.optimal || state.stop_execution;
+    return result;
+}
+
+// Regras do modo online: First Fit e Best Fit entre as bins abertas, ou
+// Harmonic-k, que separa os itens em k classes por tamanho
+enum class OnlineRule { FirstFit, BestFit, Harmonic };
+
+// Empacotamento online (--stream): cada item é colocado assim que chega, sem
+// conhecer os próximos. Uma bin é fechada e entregue a emit assim que a folga
+// fica menor que min_item, o menor item que ainda pode chegar, e a memória
+// usada é proporcional ao pico de bins abertas, não ao número de itens. Com
+// min_item pequeno, no First Fit e no Best Fit quase nenhuma bin fecha por
+// folga; max_open (0: sem limite) limita então as abertas, fechando a mais
+// cheia antes de abrir outra. O Harmonic-k já mantém no máximo k + 1
+template <typename Size>
+class OnlinePacker {
+public:
+    // Recebe o número da bin (ordem de abertura, a partir de 1) e seus itens
+    using Emit = std::function<void(size_t, const Size*, const Size*)>;
+
+    OnlinePacker(OnlineRule rule, Size capacity, Size min_item, int classes, size_t max_open, Emit emit)
+        : rule_(rule), capacity_(capacity), min_item_(std::max<Size>(min_item, 1)),
+          classes_(std::max(classes, 1)), max_open_(max_open), emit_(std::move(emit)) {
+        if (rule_ == OnlineRule::BestFit && capacity_ > MAX_BUCKET_CAPACITY)
+            throw std::invalid_argument("capacidade grande demais para o Best Fit online");
+        tree_.reset(16);
+        buckets_.reset(16, rule_ == OnlineRule::BestFit ? capacity_ : 0);
+        current_.assign(classes_ + 1, -1);
+    }
+
+    void add(Size item) {
+        if (item <= 0 || item > capacity_)
+            throw std::invalid_argument("item com tamanho fora de (0, capacidade]");
+
+        switch (rule_) {
+        case OnlineRule::FirstFit:
+            add_first_fit(item);
+            break;
+        case OnlineRule::BestFit:
+            add_best_fit(item);
+            break;
+        case OnlineRule::Harmonic:
+            add_harmonic(item);
+            break;
+        }
+    }
+
+    // Fecha as bins que ainda estão abertas, na ordem de abertura
+    void finish() {
+        std::vector<size_t> open;
+        for (size_t slot = 0; slot < slots_.size(); ++slot)
+            if (slots_[slot].open)
+                open.push_back(slot);
+        std::sort(open.begin(), open.end(), [&](size_t a, size_t b) { return slots_[a].id < slots_[b].id; });
+        for (size_t slot : open)
+            close(slot);
+    }
+
+    size_t bins() const { return opened_; }
+    size_t open_bins() const { return open_; }
+    size_t peak_open_bins() const { return peak_; }
+
+private:
+    struct Slot {
+        size_t id = 0;
+        Size load = 0;
+        bool open = false;
+        std::vector<Size> items;  // Mantém a capacidade entre reutilizações
+    };
+
+    OnlineRule rule_;
+    Size capacity_, min_item_;
+    int classes_;
+    size_t max_open_;
+    Emit emit_;
+
+    std::vector<Slot> slots_;
+    std::vector<size_t> free_;
+    size_t opened_ = 0, open_ = 0, peak_ = 0;
+
+    // First Fit: as bins ficam na árvore em ordem de abertura; as fechadas
+    // são preenchidas até a capacidade e removidas quando a árvore enche
+    FirstFitTree<Size> tree_;
+    size_t used_ = 0;
+
+    // Best Fit: bins abertas indexadas por folga
+    ResidualBuckets buckets_;
+
+    // Harmonic-k: bin aberta de cada classe, ou -1
+    std::vector<int64_t> current_;
+
+    size_t open_slot() {
+        size_t slot;
+        if (!free_.empty()) {
+            slot = free_.back();
+            free_.pop_back();
+        } else {
+            slot = slots_.size();
+            slots_.emplace_back();
+        }
+
+        start(slot);
+        return slot;
+    }
+
+    void start(size_t slot) {
+        Slot& bin = slots_[slot];
+        bin.id = ++opened_;
+        bin.load = 0;
+        bin.open = true;
+        bin.items.clear();
+        peak_ = std::max(peak_, ++open_);
+    }
+
+    void put(size_t slot, Size item) {
+        slots_[slot].load += item;
+        slots_[slot].items.push_back(item);
+    }
+
+    void close(size_t slot) {
+        Slot& bin = slots_[slot];
+        emit_(bin.id, bin.items.data(), bin.items.data() + bin.items.size());
+        bin.open = false;
+        --open_;
+
+        if (rule_ == OnlineRule::FirstFit)
+            tree_.add(slot, capacity_ - tree_.load_of(slot));
+        else
+            free_.push_back(slot);
+        if (rule_ == OnlineRule::BestFit)
+            buckets_.erase(slot);
+    }
+
+    bool closable(size_t slot) const { return capacity_ - slots_[slot].load < min_item_; }
+
+    // Antes de abrir uma bin no limite de max_open, fecha a aberta mais cheia:
+    // no Best Fit é a de menor folga no índice, no First Fit uma varredura
+    // das bins, O(max_open) por bin aberta
+    void make_room() {
+        if (max_open_ == 0 || open_ < max_open_)
+            return;
+        if (rule_ == OnlineRule::BestFit)
+            return close(buckets_.head[buckets_.at_least(0)]);
+        size_t fullest = slots_.size();
+        for (size_t slot = 0; slot < slots_.size(); ++slot)
+            if (slots_[slot].open && (fullest == slots_.size() || slots_[slot].load > slots_[fullest].load))
+                fullest = slot;
+        close(fullest);
+    }
+
+    void add_first_fit(Size item) {
+        size_t slot = tree_.first_fit(item, capacity_);
+        if (slot >= used_) {
+            make_room();
+            if (used_ == tree_.size)
+                compact();
+            slot = used_++;
+            if (slot == slots_.size())
+                slots_.emplace_back();
+            start(slot);
+        }
+
+        tree_.add(slot, item);
+        put(slot, item);
+        if (closable(slot))
+            close(slot);
+    }
+
+    // Move as bins abertas para o início, na mesma ordem, e refaz a árvore
+    // com espaço para o dobro delas
+    void compact() {
+        size_t m = 0;
+        for (size_t slot = 0; slot < used_; ++slot)
+            if (slots_[slot].open)
+                std::swap(slots_[m++], slots_[slot]);
+
+        std::vector<Size> loads(m);
+        for (size_t slot = 0; slot < m; ++slot)
+            loads[slot] = slots_[slot].load;
+
+        tree_.reset(std::max<size_t>(16, 2 * m));
+        tree_.restore(loads.data(), m, 0);
+        used_ = m;
+        slots_.resize(std::min(slots_.size(), tree_.size));
+    }
+
+    void add_best_fit(Size item) {
+        int64_t r = buckets_.at_least(item);
+        size_t slot;
+        if (r < 0) {
+            make_room();
+            slot = open_slot();
+            if (slot >= buckets_.next.size())
+                buckets_.grow(2 * slots_.size());
+        } else {
+            slot = buckets_.head[r];
+            buckets_.erase(slot);
+        }
+
+        put(slot, item);
+        if (closable(slot))
+            close(slot);
+        else
+            buckets_.insert(slot, capacity_ - slots_[slot].load);
+    }
+
+    // A classe j < k recebe os itens em (C / (j + 1), C / j], exatamente j
+    // por bin; a classe k recebe os itens <= C / k com Next Fit
+    void add_harmonic(Size item) {
+        int j = int(std::min<Size>(capacity_ / item, classes_));
+        int64_t& slot = current_[j];
+        if (slot >= 0 && slots_[slot].load + item > capacity_) {
+            close(slot);
+            slot = -1;
+        }
+        if (slot < 0)
+            slot = open_slot();
+
+        put(slot, item);
+        if (closable(slot) || (j < classes_ && slots_[slot].items.size() == size_t(j))) {
+            close(slot);
+            slot = -1;
+        }
+    }
+};
+
+#endif
@@ -1,34 +1,40 @@
 /*
   Dado um grafo G = (V, E), determinar a clique máxima,
   ou seja, o maior subconjunto de vértices onde todos estão conectados entre si.
+
+  Uso: clique [--instancia arquivo.clq] [--motor bbmc|cplex|comparar]
+              [--threads N] [--tempo segundos] [--numeracao 0|1]
+
+  O grafo é lido em formato DIMACS do arquivo ou da entrada padrão
+  (clique.clq é o exemplo de 10 vértices). Os vértices da resposta são
+  numerados a partir de 0, como na versão original; --numeracao 1 usa a
+  numeração do arquivo DIMACS, a partir de 1. O motor padrão é o
+  branch-and-bound com conjuntos em bits de clique.hpp, com as subárvores da
+  raiz divididas entre N threads (padrão: todos os núcleos) e parada
+  opcional por tempo; cplex resolve o modelo inteiro, com restrições de
+  conjuntos independentes, e comparar executa os dois e confere os tamanhos.
 */
 
 #include <ilcplex/ilocplex.h>
 #include <vector>
+#include <string>
+#include <thread>
 
-ILOSTLBEGIN
+#include "clique.hpp"
 
-int main() {
+ILOSTLBEGIN;
+
+// Modelo inteiro, mantido como referência para conferir o motor nativo.
+// Retorna false se o CPLEX não resolveu o problema
+bool solve_cplex(const Graph& graph, std::vector<int>& clique) {
     IloEnv env;
     IloModel model(env);
 
-    const int n = 10; // número de vértices
+    const int n = graph.n; // número de vértices
 
     // Variáveis binárias: x[i] = 1 se o vértice i está na clique
     IloIntVarArray x(env, n, 0, 1);
 
-    // Lista de adjacência do grafo
-    std::vector<std::vector<int>> g(n);
-    std::vector<std::pair<int, int>> edges = {
-        {0,1}, {0,2}, {0,3}, {1,3}, {2,5}, {2,3}, {5,6}, {5,7},
-        {6,3}, {6,9}, {1,4}, {3,4}, {9,7}, {8,9}, {6,7}, {3,6}
-    };
-
-    for (auto [u, v] : edges) {
-        g[u].push_back(v);
-        g[v].push_back(u);
-    }
-
     // Função objetivo: maximizar a quantidade de vértices na clique
     IloExpr clique_size(env);
     for (int v = 0; v < n; ++v)
@@ -36,39 +42,103 @@ int main() {
 
     model.add(IloMaximize(env, clique_size));
 
-    // Adiciona restrições para garantir que apenas vértices adjacentes
-    // possam estar juntos na clique
-    for (int v = 0; v < n; ++v) {
-        for (int u = v + 1; u < n; ++u) {
-            // Verifica se não há aresta entre v e u
-            bool are_connected = false;
-            for (int w : g[v]) {
-                if (w == u) {
-                    are_connected = true;
-                    break;
-                }
-            }
+    // Dois vértices não adjacentes não podem estar juntos na clique; em vez
+    // de uma restrição por par, cada conjunto independente S de uma
+    // cobertura dos pares não adjacentes dá sum_{v em S} x[v] <= 1
+    std::vector<std::vector<int>> cover = independent_set_cover(BitGraph(graph));
+    for (const auto& set : cover) {
+        IloExpr members(env);
+        for (int v : set)
+            members += x[v];
+        model.add(members <= 1);
+        members.end();
+    }
+    std::cout << "Modelo do CPLEX: " << cover.size() << " restrições de conjuntos independentes\n";
+
+    IloCplex cplex(model);
+    cplex.setOut(env.getNullStream());
 
-            if (!are_connected) {
-                model.add(x[v] + x[u] <= 1);
+    bool solved = cplex.solve();
+    if (solved) {
+        clique.clear();
+        for (int v = 0; v < n; ++v) {
+            if (cplex.getValue(x[v]) > 0.5) {
+                clique.push_back(v);
             }
         }
     }
 
-    IloCplex cplex(model);
+    env.end();
+    return solved;
+}
 
-    if (cplex.solve()) {
+int main(int argc, char* argv[]) {
+    std::string path = "-";
+    std::string engine = "bbmc";
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    int time_limit = 0;
+    int first_vertex = 0;
+    for (int i = 1; i + 1 < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--instancia")
+            path = argv[++i];
+        else if (arg == "--motor")
+            engine = argv[++i];
+        else if (arg == "--threads")
+            threads = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--tempo")
+            time_limit = std::atoi(argv[++i]);
+        else if (arg == "--numeracao")
+            first_vertex = std::atoi(argv[++i]) ? 1 : 0;
+    }
+    if (engine != "bbmc" && engine != "cplex" && engine != "comparar") {
+        std::cerr << "Motor desconhecido: " << engine << "\n";
+        return 1;
+    }
+
+    Graph graph;
+    try {
+        graph = load_dimacs(path);
+    } catch (const std::exception& e) {
+        std::cerr << "Erro na leitura da instância: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::vector<int> clique;
+    bool solved = true;
+    if (engine != "cplex") {
+        CliqueResult result = MaxClique(graph).solve(threads, time_limit);
+        clique = result.vertices;
+        std::cout << "Busca " << (result.optimal ? "completa" : "interrompida pelo tempo limite") << ": "
+                  << result.nodes << " nós em " << result.seconds << " s com " << threads << " threads\n";
+    }
+    if (engine == "cplex" || engine == "comparar") {
+        std::vector<int> reference;
+        solved = solve_cplex(graph, reference);
+        if (engine == "comparar" && solved) {
+            std::cout << "Tamanho da clique do CPLEX: " << reference.size() << "\n";
+            if (reference.size() != clique.size()) {
+                std::cout << "Divergência entre o motor nativo (" << clique.size() << ") e o CPLEX ("
+                          << reference.size() << ")!\n";
+                return 1;
+            }
+            std::cout << "Tamanhos conferem\n";
+        } else {
+            clique = reference;
+        }
+    }
+
+    if (solved) {
         std::cout << "Solução encontrada!\n";
-        std::cout << "Tamanho da clique: " << cplex.getObjValue() << "\n";
+        std::cout << "Tamanho da clique: " << clique.size() << "\n";
         std::cout << "Vértices na clique: ";
-        for (int v = 0; v < n; ++v) {
-            if (cplex.getValue(x[v]) > 0.5) {
-                std::cout << v << " ";
-            }
+        for (int v : clique) {
+            std::cout << v + first_vertex << " ";
         }
         std::cout << "\n";
     } else {
         std::cout << "Não foi possível resolver o problema.\n";
+        return 1;
     }
 
     return 0;
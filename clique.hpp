@@ -0,0 +1,451 @@
+/*
+  Clique máxima por branch-and-bound com conjuntos em bits (MaxClique), com
+  os ramos da raiz divididos entre threads, e a cobertura por conjuntos
+  independentes (independent_set_cover) com que clique.cpp fortalece o
+  modelo inteiro.
+
+  Formato da instância: DIMACS (.clq), com linhas "c comentário",
+  "p edge n m" e "e u v", vértices numerados a partir de 1.
+*/
+
+#ifndef CLIQUE_HPP
+#define CLIQUE_HPP
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <algorithm>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "input-file.hpp"
+
+struct Graph {
+    int n = 0;
+    std::vector<std::pair<int, int>> edges;  // vértices a partir de 0
+};
+
+// Lê um grafo DIMACS de path ("-" é a entrada padrão)
+inline Graph load_dimacs(const std::string& path) {
+    InputFile input(path);
+    std::istream& in = input.stream();
+
+    Graph graph;
+    bool header = false;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        char kind;
+        if (!(fields >> kind) || kind == 'c')
+            continue;
+        if (kind == 'p') {
+            std::string format;
+            long long m;
+            if (!(fields >> format >> graph.n >> m) || graph.n < 0)
+                throw std::runtime_error("linha \"p\" inválida: " + line);
+            graph.edges.reserve(m);
+            header = true;
+        } else if (kind == 'e') {
+            int u, v;
+            if (!header)
+                throw std::runtime_error("aresta antes da linha \"p\"");
+            if (!(fields >> u >> v) || u < 1 || v < 1 || u > graph.n || v > graph.n)
+                throw std::runtime_error("aresta inválida: " + line);
+            if (u != v)
+                graph.edges.push_back({u - 1, v - 1});
+        }
+    }
+    if (!header)
+        throw std::runtime_error("linha \"p edge n m\" não encontrada");
+    return graph;
+}
+
+// Matriz de adjacência em bits, uma linha de n bits por vértice
+class BitGraph {
+public:
+    BitGraph(int n) : n_(n), words_((n + 63) / 64), bits_(size_t(n) * words_, 0) {}
+
+    explicit BitGraph(const Graph& graph) : BitGraph(graph.n) {
+        for (auto [u, v] : graph.edges)
+            add_edge(u, v);
+    }
+
+    void add_edge(int u, int v) {
+        bits_[size_t(u) * words_ + v / 64] |= uint64_t(1) << (v % 64);
+        bits_[size_t(v) * words_ + u / 64] |= uint64_t(1) << (u % 64);
+    }
+
+    int size() const { return n_; }
+    size_t words() const { return words_; }
+    const uint64_t* row(int v) const { return bits_.data() + size_t(v) * words_; }
+    bool adjacent(int u, int v) const { return row(u)[v / 64] >> (v % 64) & 1; }
+
+private:
+    int n_;
+    size_t words_;
+    std::vector<uint64_t> bits_;
+};
+
+// Conjuntos independentes maximais de G que cobrem todos os pares não
+// adjacentes, para as restrições sum_{v em S} x_v <= 1 do modelo inteiro:
+// cada uma substitui todas as restrições de pares x_u + x_v <= 1 dentro de S
+// e é bem mais forte na relaxação linear. Primeiro vem uma coloração gulosa
+// de G (uma cobertura por cliques do complemento), com cada classe estendida
+// até ficar maximal; depois, cada par ainda descoberto {u, v} gera um
+// conjunto a partir de u que prefere os não vizinhos de u ainda descobertos.
+// Tudo é feito com operações de palavras sobre as linhas de bits
+inline std::vector<std::vector<int>> independent_set_cover(const BitGraph& graph) {
+    int n = graph.size();
+    size_t words = graph.words();
+    auto bit = [](int v) { return uint64_t(1) << (v % 64); };
+
+    std::vector<uint64_t> all(words, 0);
+    for (int v = 0; v < n; ++v)
+        all[v / 64] |= bit(v);
+
+    // Pares já cobertos por algum conjunto, com a diagonal marcada
+    std::vector<uint64_t> covered(size_t(n) * words, 0);
+    for (int v = 0; v < n; ++v)
+        covered[size_t(v) * words + v / 64] |= bit(v);
+
+    std::vector<std::vector<int>> sets;
+    std::vector<uint64_t> members(words), free(words);
+    std::vector<int> set;
+
+    // Estende set (cujos membros estão em members e cujos não vizinhos livres
+    // estão em free) até ficar maximal, escolhendo primeiro os vértices de
+    // prefer, e registra os pares cobertos
+    auto grow = [&](const std::vector<uint64_t>& prefer) {
+        for (bool preferred : {true, false}) {
+            for (size_t w = 0; w < words; ++w) {
+                uint64_t pending;
+                while ((pending = preferred ? free[w] & prefer[w] : free[w]) != 0) {
+                    int v = 64 * w + __builtin_ctzll(pending);
+                    set.push_back(v);
+                    members[w] |= bit(v);
+                    const uint64_t* neighbors = graph.row(v);
+                    for (size_t x = 0; x < words; ++x)
+                        free[x] &= ~neighbors[x];
+                    free[w] &= ~bit(v);
+                }
+            }
+        }
+        if (set.size() < 2)
+            return;
+        for (int v : set)
+            for (size_t w = 0; w < words; ++w)
+                covered[size_t(v) * words + w] |= members[w];
+        sets.push_back(set);
+    };
+
+    // Coloração gulosa: cada classe prefere os vértices ainda sem cor
+    std::vector<uint64_t> uncolored = all;
+    while (std::any_of(uncolored.begin(), uncolored.end(), [](uint64_t w) { return w != 0; })) {
+        set.clear();
+        std::fill(members.begin(), members.end(), 0);
+        free = all;
+        grow(uncolored);
+        for (size_t w = 0; w < words; ++w)
+            uncolored[w] &= ~members[w];
+    }
+
+    // Pares que a coloração não cobriu
+    std::vector<uint64_t> uncovered(words);
+    for (int u = 0; u < n; ++u) {
+        const uint64_t* neighbors = graph.row(u);
+        while (true) {
+            bool any = false;
+            for (size_t w = 0; w < words; ++w) {
+                uncovered[w] = all[w] & ~neighbors[w] & ~covered[size_t(u) * words + w];
+                any = any || uncovered[w];
+            }
+            if (!any)
+                break;
+            set.assign(1, u);
+            std::fill(members.begin(), members.end(), 0);
+            members[u / 64] |= bit(u);
+            for (size_t w = 0; w < words; ++w)
+                free[w] = all[w] & ~neighbors[w];
+            free[u / 64] &= ~bit(u);
+            grow(uncovered);
+        }
+    }
+    return sets;
+}
+
+struct CliqueResult {
+    std::vector<int> vertices;  // numeração original, em ordem crescente
+    bool optimal = false;       // false se o tempo limite interrompeu a busca
+    uint64_t nodes = 0;
+    double seconds = 0;
+};
+
+// Branch-and-bound de clique máxima com conjuntos em bits (BBMC, de San
+// Segundo, com a poda do MCS de Tomita). Os vértices são renumerados pela
+// ordem smallest-last, de modo que o núcleo mais denso vem primeiro. Em cada
+// nó, os candidatos P são coloridos gulosamente, uma classe independente
+// por vez; a cor de um vértice limita o tamanho de qualquer clique formada
+// por ele e pelos candidatos que vêm antes, e só os vértices cuja cor pode
+// superar a incumbente viram ramos, do último para o primeiro. Os ramos da
+// raiz são subproblemas independentes, divididos entre as threads por um
+// contador compartilhado, com a incumbente comum para as podas
+class MaxClique {
+public:
+    explicit MaxClique(const Graph& graph) : graph_(relabel(graph)) {}
+
+    CliqueResult solve(int threads, int time_limit) {
+        start_ = std::chrono::steady_clock::now();
+        deadline_ = start_ + std::chrono::seconds(time_limit > 0 ? time_limit : 1 << 30);
+        size_t words = graph_.words();
+        int n = graph_.size();
+
+        // Incumbente inicial: clique gulosa na nova ordem
+        for (int v = 0; v < n; ++v) {
+            bool joins = true;
+            for (int u : best_)
+                joins = joins && graph_.adjacent(u, v);
+            if (joins)
+                best_.push_back(v);
+        }
+        best_size_ = best_.size();
+
+        // Coloração da raiz, com a mesma poda de expand para a clique vazia:
+        // cada ramo i parte de {v_i} com os candidatos que a raiz ainda não
+        // descartou antes dele
+        Worker root(graph_);
+        std::vector<uint64_t> all(words, 0);
+        for (int v = 0; v < n; ++v)
+            all[v / 64] |= uint64_t(1) << (v % 64);
+        Worker::Level& top = root.level(0);
+        top.candidates = all;
+        top.end = words;
+        root.color(top, best_size_ + 1);
+        const std::vector<int>& order = top.order;
+        const std::vector<int>& colors = top.colors;
+
+        std::atomic<long> next(long(order.size()) - 1);
+        auto run = [&]() {
+            Worker worker(graph_);
+            std::vector<uint64_t> candidates;
+            for (long i; (i = next--) >= 0 && !stop_;) {
+                if (colors[i] <= best_size_)
+                    break;
+                candidates = all;
+                for (size_t j = i + 1; j < order.size(); ++j)
+                    candidates[order[j] / 64] &= ~(uint64_t(1) << (order[j] % 64));
+                worker.branch(*this, candidates, order[i]);
+            }
+            nodes_ += worker.nodes;
+        };
+
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; ++t)
+            pool.emplace_back(run);
+        run();
+        for (auto& thread : pool)
+            thread.join();
+
+        CliqueResult result;
+        for (int v : best_)
+            result.vertices.push_back(original_[v]);
+        std::sort(result.vertices.begin(), result.vertices.end());
+        result.optimal = !stop_;
+        result.nodes = nodes_ + 1;
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+        return result;
+    }
+
+private:
+    std::vector<int> original_;  // vértice original de cada posição na ordem; antes de graph_,
+                                 // que é construído por relabel
+    BitGraph graph_;
+
+    std::mutex best_mutex_;
+    std::vector<int> best_;
+    std::atomic<int> best_size_{0};
+    std::atomic<bool> stop_{false};
+    std::atomic<uint64_t> nodes_{0};
+    std::chrono::steady_clock::time_point start_, deadline_;
+
+    // Ordem smallest-last: remove repetidamente um vértice de grau mínimo
+    // no que resta; a ordem final é a inversa da remoção
+    BitGraph relabel(const Graph& graph) {
+        int n = graph.n;
+        std::vector<std::vector<int>> adjacency(n);
+        for (auto [u, v] : graph.edges) {
+            adjacency[u].push_back(v);
+            adjacency[v].push_back(u);
+        }
+        for (auto& list : adjacency) {
+            std::sort(list.begin(), list.end());
+            list.erase(std::unique(list.begin(), list.end()), list.end());
+        }
+
+        // Baldes por grau, com remoção preguiçosa das entradas antigas
+        std::vector<int> degree(n);
+        std::vector<std::vector<int>> buckets(n + 1);
+        for (int v = 0; v < n; ++v) {
+            degree[v] = adjacency[v].size();
+            buckets[degree[v]].push_back(v);
+        }
+        std::vector<char> removed(n, 0);
+        original_.assign(n, 0);
+        int low = 0;
+        for (int k = n; k-- > 0;) {
+            int v;
+            while (true) {
+                while (buckets[low].empty())
+                    ++low;
+                v = buckets[low].back();
+                buckets[low].pop_back();
+                if (!removed[v] && degree[v] == low)
+                    break;
+            }
+            removed[v] = 1;
+            original_[k] = v;
+            for (int u : adjacency[v])
+                if (!removed[u]) {
+                    buckets[--degree[u]].push_back(u);
+                    low = std::min(low, degree[u]);
+                }
+        }
+
+        std::vector<int> position(n);
+        for (int k = 0; k < n; ++k)
+            position[original_[k]] = k;
+        BitGraph relabeled(n);
+        for (auto [u, v] : graph.edges)
+            relabeled.add_edge(position[u], position[v]);
+        return relabeled;
+    }
+
+    void improve(const std::vector<int>& clique) {
+        std::lock_guard<std::mutex> lock(best_mutex_);
+        if (clique.size() > best_.size()) {
+            best_ = clique;
+            best_size_ = clique.size();
+        }
+    }
+
+    // Estado de uma thread: candidatos, vértices coloridos e cores de cada
+    // profundidade, reaproveitados entre os nós. Os candidatos de cada
+    // profundidade só ocupam as palavras [begin, end), e todas as operações
+    // de bits se limitam a elas
+    struct Worker {
+        struct Level {
+            std::vector<uint64_t> candidates;
+            size_t begin = 0, end = 0;
+            std::vector<int> order, colors;
+        };
+
+        const BitGraph& graph;
+        std::deque<Level> levels;  // deque: crescer não invalida os níveis em uso
+        std::vector<uint64_t> uncolored, available;
+        std::vector<int> clique;
+        uint64_t nodes = 0;
+
+        explicit Worker(const BitGraph& graph) : graph(graph), uncolored(graph.words()), available(graph.words()) {}
+
+        Level& level(size_t depth) {
+            while (levels.size() <= depth)
+                levels.push_back({std::vector<uint64_t>(graph.words()), 0, 0, {}, {}});
+            return levels[depth];
+        }
+
+        // Colore os candidatos do nível com classes independentes gulosas, do
+        // menor índice para o maior, e guarda em order/colors só os vértices
+        // com cor >= min_color, em ordem crescente de cor: os de cor menor
+        // não podem levar a uma clique maior que a incumbente
+        void color(Level& node, int min_color) {
+            size_t first = node.begin, end = node.end;
+            node.order.clear();
+            node.colors.clear();
+            std::copy(node.candidates.begin() + first, node.candidates.begin() + end, uncolored.begin() + first);
+
+            for (int k = 1;; ++k) {
+                while (first < end && uncolored[first] == 0)
+                    ++first;
+                if (first == end)
+                    break;
+                std::copy(uncolored.begin() + first, uncolored.begin() + end, available.begin() + first);
+                for (size_t w = first; w < end; ++w) {
+                    while (available[w]) {
+                        int v = 64 * w + __builtin_ctzll(available[w]);
+                        uint64_t bit = uint64_t(1) << (v % 64);
+                        uncolored[w] &= ~bit;
+                        available[w] &= ~bit;
+                        const uint64_t* neighbors = graph.row(v);
+                        for (size_t x = w; x < end; ++x)
+                            available[x] &= ~neighbors[x];
+                        if (k >= min_color) {
+                            node.order.push_back(v);
+                            node.colors.push_back(k);
+                        }
+                    }
+                }
+            }
+        }
+
+        // Filho do nível com os candidatos vizinhos de v, com as palavras
+        // vazias das pontas aparadas; retorna false se ficou vazio
+        bool intersect(const Level& parent, int v, Level& child) const {
+            const uint64_t* neighbors = graph.row(v);
+            size_t begin = parent.end, end = parent.begin;
+            for (size_t w = parent.begin; w < parent.end; ++w) {
+                child.candidates[w] = parent.candidates[w] & neighbors[w];
+                if (child.candidates[w]) {
+                    begin = std::min(begin, w);
+                    end = w + 1;
+                }
+            }
+            child.begin = begin;
+            child.end = end;
+            return begin < end;
+        }
+
+        // Ramo da raiz: clique {v} com os candidatos P vizinhos de v
+        void branch(MaxClique& search, const std::vector<uint64_t>& P, int v) {
+            Level& root = level(0);
+            root.candidates = P;
+            root.begin = 0;
+            root.end = graph.words();
+            clique.assign(1, v);
+            if (intersect(root, v, level(1)))
+                expand(search, 1);
+            else
+                search.improve(clique);
+        }
+
+        void expand(MaxClique& search, size_t depth) {
+            if (++nodes % 1024 == 0 && std::chrono::steady_clock::now() >= search.deadline_)
+                search.stop_ = true;
+            if (search.stop_)
+                return;
+
+            level(depth + 1);
+            Level& node = levels[depth];
+            color(node, search.best_size_ - int(clique.size()) + 1);
+
+            for (size_t i = node.order.size(); i-- > 0;) {
+                if (int(clique.size()) + node.colors[i] <= search.best_size_ || search.stop_)
+                    return;
+                int v = node.order[i];
+                clique.push_back(v);
+                if (intersect(node, v, levels[depth + 1]))
+                    expand(search, depth + 1);
+                else if (int(clique.size()) > search.best_size_)
+                    search.improve(clique);
+                clique.pop_back();
+                node.candidates[v / 64] &= ~(uint64_t(1) << (v % 64));
+            }
+        }
+    };
+};
+
+#endif
@@ -10,30 +10,45 @@
 
   Cada cliente deve ser atendido por exatamente um depósito,
   e um depósito só pode atender se estiver instalado.
+
+  Uso: facilities [--instancia arquivo.dat] [--motor lagrange|busca|cplex|comparar]
+                  [--threads N] [--iteracoes K] [--vizinhos K] [--tempo segundos]
+
+  A instância é lida do arquivo ou da entrada padrão (formato em
+  facilities.hpp; facilities.dat é o exemplo de 3 depósitos e 4 clientes).
+  O motor padrão é a relaxação lagrangiana com subgradiente, que devolve a
+  melhor solução encontrada, refinada pela busca local, com um limitante
+  inferior comprovado e o gap; busca é só a busca local de instalar, fechar
+  e trocar depósitos, com listas dos K depósitos mais próximos de cada
+  cliente (16 por padrão), para replanejamento rápido sem limitante; cplex
+  resolve o modelo inteiro original e comparar executa a relaxação e o
+  CPLEX e confere que o ótimo fica entre o limitante e a solução. --tempo
+  limita os motores nativos.
 */
 
 #include <ilcplex/ilocplex.h>
 #include <vector>
+#include <string>
 #include <iostream>
+#include <iomanip>
+#include <thread>
+#include <cmath>
+
+#include "facilities.hpp"
 
 ILOSTLBEGIN;
 
-int main() {
+// Modelo inteiro original, mantido como referência para conferir o motor
+// lagrangiano. Retorna false se o CPLEX não resolveu o problema
+bool solve_cplex(const FacilityInstance& instance, FacilityResult& result) {
     IloEnv env;
     IloModel model(env);
 
-    int n = 3; // Número de depósitos possíveis
-    int m = 4; // Número de clientes
+    int n = instance.n; // Número de depósitos possíveis
+    int m = instance.m; // Número de clientes
 
     // Custo de instalação de cada depósito
-    double f[n] = {100, 150, 120};
-
-    // Custo de atendimento do depósito i ao cliente j
-    std::vector<std::vector<double>> c = {
-        {20, 104, 11, 325},
-        {28, 104, 325, 8},
-        {325, 5, 5, 96}
-    };
+    const std::vector<double>& f = instance.fixed;
 
     // Variável binária: y[i] = 1 se depósito i for instalado
     IloIntVarArray y(env, n, 0, 1);
@@ -50,10 +65,10 @@ int main() {
     for (int i = 0; i < n; ++i)
         custoTotal += f[i] * y[i];
 
-    // Soma dos custos de atendimento
+    // Soma dos custos de atendimento do depósito i ao cliente j
     for (int i = 0; i < n; ++i)
         for (int j = 0; j < m; ++j)
-            custoTotal += c[i][j] * x[i][j];
+            custoTotal += instance.row(i)[j] * x[i][j];
 
     model.add(IloMinimize(env, custoTotal));
 
@@ -72,20 +87,104 @@ int main() {
 
     // Resolver o modelo
     IloCplex cplex(model);
-    if (!cplex.solve()) {
-        std::cout << "Problema não resolvido.\n";
+    cplex.setOut(env.getNullStream());
+    bool solved = cplex.solve();
+
+    if (solved) {
+        result.cost = result.bound = cplex.getObjValue();
+        result.open.assign(n, 0);
+        result.assignment.assign(m, -1);
+        for (int i = 0; i < n; ++i) {
+            result.open[i] = cplex.getValue(y[i]) > 0.5;
+            for (int j = 0; j < m; ++j)
+                if (cplex.getValue(x[i][j]) > 0.5)
+                    result.assignment[j] = i;
+        }
+    }
+
+    env.end();
+    return solved;
+}
+
+int main(int argc, char* argv[]) {
+    std::string path = "-";
+    std::string engine = "lagrange";
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    int iterations = 1000;
+    int neighbors = 16;
+    double time_limit = 0;
+    for (int i = 1; i + 1 < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--instancia")
+            path = argv[++i];
+        else if (arg == "--motor")
+            engine = argv[++i];
+        else if (arg == "--threads")
+            threads = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--iteracoes")
+            iterations = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--vizinhos")
+            neighbors = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--tempo")
+            time_limit = std::atof(argv[++i]);
+    }
+    if (engine != "lagrange" && engine != "busca" && engine != "cplex" && engine != "comparar") {
+        std::cerr << "Motor desconhecido: " << engine << "\n";
         return 1;
     }
 
+    FacilityInstance instance;
+    try {
+        instance = load_facilities(path);
+    } catch (const std::exception& e) {
+        std::cerr << "Erro na leitura da instância: " << e.what() << "\n";
+        return 1;
+    }
+
+    FacilityResult result;
+    if (engine == "busca") {
+        result = LocalSearchFacilities(instance, neighbors).solve(time_limit);
+        std::cout << "Busca local: " << result.iterations << " movimentos em " << result.seconds << " s\n";
+    } else if (engine != "cplex") {
+        result = LagrangianFacilities(instance, threads, neighbors).solve(iterations, time_limit);
+        std::cout << "Relaxação lagrangiana: " << result.iterations << " iterações em " << result.seconds
+                  << " s com " << threads << " threads\n";
+    }
+    if (engine == "cplex" || engine == "comparar") {
+        FacilityResult reference;
+        if (!solve_cplex(instance, reference)) {
+            std::cout << "Problema não resolvido.\n";
+            return 1;
+        }
+        if (engine == "comparar") {
+            std::cout << "Custo ótimo do CPLEX: " << reference.cost << "\n";
+            double tolerance = 1e-6 * std::max(1.0, std::abs(reference.cost));
+            if (reference.cost < result.bound - tolerance || reference.cost > result.cost + tolerance) {
+                std::cout << "O ótimo do CPLEX está fora do intervalo [" << result.bound << ", " << result.cost
+                          << "]!\n";
+                return 1;
+            }
+            std::cout << "Limitante e solução conferem\n";
+        } else {
+            result = reference;
+        }
+    }
+
     std::cout << "Problema resolvido com sucesso!\n";
-    std::cout << "Custo mínimo total: " << cplex.getObjValue() << "\n\n";
+    std::cout << "Custo mínimo total: " << result.cost << "\n";
+    if (std::isfinite(result.bound)) {
+        double gap = 100 * (result.cost - result.bound) / std::max(1e-9, std::abs(result.cost));
+        std::cout << "Limitante inferior: " << result.bound << " (gap " << std::fixed << std::setprecision(4)
+                  << gap << "%)\n" << std::defaultfloat;
+    }
+    std::cout << "\n";
 
-    for (int i = 0; i < n; ++i) {
-        if (cplex.getValue(y[i]) > 0.5) {
+    for (int i = 0; i < instance.n; ++i) {
+        if (result.open[i]) {
             std::cout << "Depósito " << i << " instalado.\n";
             std::cout << "  Clientes atendidos: ";
-            for (int j = 0; j < m; ++j) {
-                if (cplex.getValue(x[i][j]) > 0.5)
+            for (int j = 0; j < instance.m; ++j) {
+                if (result.assignment[j] == i)
                     std::cout << j << " ";
             }
             std::cout << "\n";
@@ -0,0 +1,637 @@
+/*
+  Localização de depósitos sem capacidade. LocalSearchFacilities instala,
+  fecha e troca depósitos para respostas rápidas, sem limitante;
+  LagrangianFacilities otimiza o limitante lagrangiano por subgradiente,
+  refina com a busca local os conjuntos de depósitos da relaxação e devolve
+  a melhor solução com o gap comprovado. Ambos percorrem a matriz de custos
+  linha a linha, com núcleos AVX2 escolhidos em tempo de execução.
+
+  Formato da instância: "n m", seguido dos n custos de instalação e de n
+  linhas com os m custos de atendimento c[i][j] de cada depósito i.
+*/
+
+#ifndef FACILITIES_HPP
+#define FACILITIES_HPP
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <limits>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define FACILITIES_X86
+#endif
+
+#include "input-file.hpp"
+
+struct FacilityInstance {
+    int n = 0, m = 0;                // depósitos possíveis e clientes
+    std::vector<double> fixed;       // custo de instalação de cada depósito
+    std::vector<double> cost;        // c[i][j] em cost[i * m + j], linha por depósito
+
+    const double* row(int i) const { return cost.data() + size_t(i) * m; }
+};
+
+struct FacilityResult {
+    double cost = 0;                 // custo da melhor solução encontrada
+    double bound = 0;                // limitante inferior lagrangiano (-inf na busca local)
+    std::vector<char> open;          // depósitos instalados
+    std::vector<int> assignment;     // depósito que atende cada cliente
+    int iterations = 0;              // iterações do subgradiente ou movimentos da busca
+    double seconds = 0;
+};
+
+// Lê a instância de path ("-" é a entrada padrão)
+inline FacilityInstance load_facilities(const std::string& path) {
+    InputFile input(path);
+    std::istream& in = input.stream();
+
+    FacilityInstance instance;
+    if (!(in >> instance.n >> instance.m) || instance.n < 1 || instance.m < 1)
+        throw std::runtime_error("cabeçalho inválido: esperado \"n m\"");
+    instance.fixed.resize(instance.n);
+    instance.cost.resize(size_t(instance.n) * instance.m);
+    for (double& f : instance.fixed)
+        if (!(in >> f))
+            throw std::runtime_error("custo de instalação inválido");
+    for (double& c : instance.cost)
+        if (!(in >> c))
+            throw std::runtime_error("custo de atendimento inválido");
+    return instance;
+}
+
+// Núcleos sobre uma linha de custos c[i][0..m): soma de min(0, c - lambda),
+// contagem dos clientes com c < lambda e mínimo acumulado. As versões AVX2
+// fazem 4 clientes por instrução e são escolhidas em tempo de execução
+inline double reduced_sum_scalar(const double* c, const double* lambda, size_t m, size_t from) {
+    double sum = 0;
+    for (size_t j = from; j < m; ++j)
+        sum += std::min(0.0, c[j] - lambda[j]);
+    return sum;
+}
+
+inline void count_below_scalar(const double* c, const double* lambda, double* count, size_t m, size_t from) {
+    for (size_t j = from; j < m; ++j)
+        count[j] += c[j] < lambda[j];
+}
+
+inline void min_into_scalar(const double* c, double* best, size_t m, size_t from) {
+    for (size_t j = from; j < m; ++j)
+        best[j] = std::min(best[j], c[j]);
+}
+
+#ifdef FACILITIES_X86
+__attribute__((target("avx2")))
+inline double reduced_sum_avx2(const double* c, const double* lambda, size_t m) {
+    __m256d zero = _mm256_setzero_pd(), sum = zero;
+    size_t j = 0;
+    for (; j + 4 <= m; j += 4)
+        sum = _mm256_add_pd(sum, _mm256_min_pd(_mm256_sub_pd(_mm256_loadu_pd(c + j), _mm256_loadu_pd(lambda + j)), zero));
+    double lanes[4];
+    _mm256_storeu_pd(lanes, sum);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + reduced_sum_scalar(c, lambda, m, j);
+}
+
+__attribute__((target("avx2")))
+inline void count_below_avx2(const double* c, const double* lambda, double* count, size_t m) {
+    __m256d one = _mm256_set1_pd(1.0);
+    size_t j = 0;
+    for (; j + 4 <= m; j += 4) {
+        __m256d below = _mm256_cmp_pd(_mm256_loadu_pd(c + j), _mm256_loadu_pd(lambda + j), _CMP_LT_OQ);
+        _mm256_storeu_pd(count + j, _mm256_add_pd(_mm256_loadu_pd(count + j), _mm256_and_pd(below, one)));
+    }
+    count_below_scalar(c, lambda, count, m, j);
+}
+
+__attribute__((target("avx2")))
+inline void min_into_avx2(const double* c, double* best, size_t m) {
+    size_t j = 0;
+    for (; j + 4 <= m; j += 4)
+        _mm256_storeu_pd(best + j, _mm256_min_pd(_mm256_loadu_pd(best + j), _mm256_loadu_pd(c + j)));
+    min_into_scalar(c, best, m, j);
+}
+#endif
+
+inline bool facilities_avx2() {
+#ifdef FACILITIES_X86
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+#else
+    return false;
+#endif
+}
+
+inline double reduced_sum(const double* c, const double* lambda, size_t m) {
+#ifdef FACILITIES_X86
+    if (facilities_avx2())
+        return reduced_sum_avx2(c, lambda, m);
+#endif
+    return reduced_sum_scalar(c, lambda, m, 0);
+}
+
+inline void count_below(const double* c, const double* lambda, double* count, size_t m) {
+#ifdef FACILITIES_X86
+    if (facilities_avx2())
+        return count_below_avx2(c, lambda, count, m);
+#endif
+    count_below_scalar(c, lambda, count, m, 0);
+}
+
+inline void min_into(const double* c, double* best, size_t m) {
+#ifdef FACILITIES_X86
+    if (facilities_avx2())
+        return min_into_avx2(c, best, m);
+#endif
+    min_into_scalar(c, best, m, 0);
+}
+
+// Busca local com movimentos de instalar, fechar e trocar depósitos, para
+// replanejamento rápido. Cada cliente j guarda o melhor e o segundo melhor
+// depósito instalado (d1[j] <= d2[j]), e com eles a busca mantém, para todos
+// os depósitos ao mesmo tempo:
+//   loss[o]     = sum_{j: b1[j] = o} (d2[j] - d1[j]), o aumento ao fechar o
+//   gain[i]     = sum_j max(0, d1[j] - c[i][j]), a economia ao instalar i
+//   extra[i][o] = sum_{j: b1[j] = o, c[i][j] < d2[j]} (d2[j] - max(c[i][j], d1[j]))
+// de forma que fechar o custa loss[o] - f[o], instalar i custa f[i] - gain[i]
+// e trocar o por i custa f[i] - gain[i] - f[o] + loss[o] - extra[i][o], sem
+// percorrer os clientes. gain e extra só somam os depósitos da lista de
+// candidatos de cada cliente (os k mais próximos, contíguos por cliente), o
+// que só subestima a economia: todo movimento aceito melhora de fato a
+// solução; quando nenhum movimento estimado melhora, a economia de instalar
+// cada depósito é calculada exatamente sobre todos os clientes (reduced_sum),
+// já que com poucos depósitos instalados os candidatos a deixam de fora com
+// frequência. Ao aplicar um movimento, uma passada pelas linhas dos depósitos
+// envolvidos encontra os clientes cujo b1 ou b2 muda, e só eles têm a
+// contribuição retirada e somada de novo. A busca parte do melhor depósito
+// isolado, ou de um conjunto dado (como o da relaxação lagrangiana), aplica
+// sempre o melhor movimento e para no ótimo local ou no limite de tempo. extra é uma matriz n x n, e por isso as trocas só são
+// consideradas até 4096 depósitos
+class LocalSearchFacilities {
+public:
+    LocalSearchFacilities(const FacilityInstance& instance, int neighbors)
+        : instance_(instance), k_(std::max(1, std::min(neighbors, instance.n))),
+          swaps_(instance.n <= 4096) {}
+
+    // Parte dos depósitos marcados em initial ou, se nenhum, do depósito que
+    // sozinho atende todos mais barato. As listas de candidatos são montadas
+    // na primeira chamada e reaproveitadas nas seguintes
+    FacilityResult solve(double time_limit, const std::vector<char>& initial = {}) {
+        auto start = std::chrono::steady_clock::now();
+        int n = instance_.n, m = instance_.m;
+        if (near_.empty())
+            build_candidates();
+
+        open_.assign(n, 0);
+        open_list_.clear();
+        position_.assign(n, -1);
+        for (int i = 0; i < int(initial.size()); ++i)
+            if (initial[i])
+                open_facility(i);
+        if (open_list_.empty()) {
+            int first = 0;
+            for (int i = 1; i < n; ++i)
+                if (instance_.fixed[i] + total_[i] < instance_.fixed[first] + total_[first])
+                    first = i;
+            open_facility(first);
+        }
+        best_.resize(m);
+        second_.resize(m);
+        best_cost_.resize(m);
+        second_cost_.resize(m);
+        cost_ = 0;
+        for (int i : open_list_)
+            cost_ += instance_.fixed[i];
+        for (int j = 0; j < m; ++j) {
+            reassign(j);
+            cost_ += best_cost_[j];
+        }
+
+        gain_.assign(n, 0.0);
+        loss_.assign(n, 0.0);
+        if (swaps_)
+            extra_.assign(size_t(n) * n, 0.0);
+        for (int j = 0; j < m; ++j)
+            contribute(j, 1);
+
+        FacilityResult result;
+        while (time_limit <= 0 ||
+               std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() < time_limit) {
+            int in = -1, out = -1;
+            if (!best_move(in, out) && !best_exact_add(in))
+                break;
+            apply(in, out);
+            ++result.iterations;
+        }
+
+        result.open.assign(n, 0);
+        result.assignment = best_;
+        result.cost = 0;
+        for (int j = 0; j < m; ++j) {
+            result.open[best_[j]] = 1;
+            result.cost += best_cost_[j];
+        }
+        for (int i = 0; i < n; ++i)
+            if (result.open[i])
+                result.cost += instance_.fixed[i];
+        result.bound = -std::numeric_limits<double>::infinity();
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+private:
+    struct Candidate {
+        double cost;
+        int facility;
+    };
+
+    const FacilityInstance& instance_;
+    int k_;
+    bool swaps_;
+    std::vector<Candidate> near_;     // k depósitos mais próximos de cada cliente, em near_[j * k_ ...]
+    std::vector<double> total_;       // custo de atender todos os clientes por cada depósito
+    std::vector<char> open_;
+    std::vector<int> open_list_, position_;
+    std::vector<int> best_, second_;  // b1[j] e b2[j] (-1 se só há um depósito instalado)
+    std::vector<double> best_cost_, second_cost_;
+    std::vector<double> gain_, loss_, extra_;
+    double cost_ = 0;
+
+    // Listas de candidatos, montadas linha a linha da matriz de custos com
+    // inserção ordenada nos k melhores de cada cliente
+    void build_candidates() {
+        int n = instance_.n, m = instance_.m;
+        near_.assign(size_t(m) * k_, Candidate{std::numeric_limits<double>::infinity(), -1});
+        total_.assign(n, 0.0);
+        for (int i = 0; i < n; ++i) {
+            const double* c = instance_.row(i);
+            double sum = 0;
+            for (int j = 0; j < m; ++j) {
+                sum += c[j];
+                Candidate* list = near_.data() + size_t(j) * k_;
+                if (c[j] >= list[k_ - 1].cost)
+                    continue;
+                int r = k_ - 1;
+                for (; r > 0 && list[r - 1].cost > c[j]; --r)
+                    list[r] = list[r - 1];
+                list[r] = Candidate{c[j], i};
+            }
+            total_[i] = sum;
+        }
+    }
+
+    void open_facility(int i) {
+        open_[i] = 1;
+        position_[i] = int(open_list_.size());
+        open_list_.push_back(i);
+    }
+
+    void close_facility(int i) {
+        open_[i] = 0;
+        int last = open_list_.back();
+        open_list_[position_[i]] = last;
+        position_[last] = position_[i];
+        open_list_.pop_back();
+        position_[i] = -1;
+    }
+
+    // Soma (sign = 1) ou retira (sign = -1) a parcela do cliente j em loss,
+    // gain e extra
+    void contribute(int j, double sign) {
+        int b1 = best_[j], b2 = second_[j];
+        double d1 = best_cost_[j], d2 = second_cost_[j];
+        if (b2 >= 0)
+            loss_[b1] += sign * (d2 - d1);
+        const Candidate* list = near_.data() + size_t(j) * k_;
+        for (int r = 0; r < k_ && list[r].cost < d2; ++r) {
+            int i = list[r].facility;
+            if (i == b1)
+                continue;
+            if (list[r].cost < d1)
+                gain_[i] += sign * (d1 - list[r].cost);
+            if (swaps_ && b2 >= 0)
+                extra_[size_t(i) * instance_.n + b1] += sign * (d2 - std::max(list[r].cost, d1));
+        }
+    }
+
+    // Recalcula b1 e b2 do cliente j pela lista de candidatos, ou por todos
+    // os depósitos instalados se ela tiver menos de dois
+    void reassign(int j) {
+        int found[2] = {-1, -1};
+        double value[2] = {std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()};
+        int count = 0;
+        const Candidate* list = near_.data() + size_t(j) * k_;
+        for (int r = 0; r < k_ && count < 2; ++r)
+            if (open_[list[r].facility]) {
+                found[count] = list[r].facility;
+                value[count++] = list[r].cost;
+            }
+        if (count < 2) {
+            found[0] = found[1] = -1;
+            value[0] = value[1] = std::numeric_limits<double>::infinity();
+            for (int i : open_list_) {
+                double c = instance_.row(i)[j];
+                if (c < value[0]) {
+                    found[1] = found[0], value[1] = value[0];
+                    found[0] = i, value[0] = c;
+                } else if (c < value[1]) {
+                    found[1] = i, value[1] = c;
+                }
+            }
+        }
+        best_[j] = found[0], best_cost_[j] = value[0];
+        second_[j] = found[1], second_cost_[j] = value[1];
+    }
+
+    // Melhor movimento que reduz o custo: instalar in, fechar out ou ambos
+    bool best_move(int& in, int& out) const {
+        int n = instance_.n;
+        const std::vector<double>& f = instance_.fixed;
+        size_t q = open_list_.size();
+        double best = -1e-9 * std::max(1.0, std::abs(cost_));
+        bool found = false;
+        auto consider = [&](double delta, int i, int o) {
+            if (delta < best) {
+                best = delta;
+                in = i, out = o;
+                found = true;
+            }
+        };
+
+        std::vector<double> drop(q);
+        for (size_t r = 0; r < q; ++r) {
+            int o = open_list_[r];
+            drop[r] = loss_[o] - f[o];
+            if (q >= 2)
+                consider(drop[r], -1, o);
+        }
+        for (int i = 0; i < n; ++i) {
+            if (open_[i])
+                continue;
+            double add = f[i] - gain_[i];
+            consider(add, i, -1);
+            if (q == 1) {
+                // Com um só depósito, a troca muda o atendimento de todos
+                int o = open_list_[0];
+                consider(f[i] - f[o] + total_[i] - total_[o], i, o);
+            } else if (swaps_) {
+                const double* e = extra_.data() + size_t(i) * n;
+                for (size_t r = 0; r < q; ++r)
+                    consider(add + drop[r] - e[open_list_[r]], i, open_list_[r]);
+            }
+        }
+        return found;
+    }
+
+    // Instalação de maior economia calculada sobre todos os clientes, usada
+    // quando as estimativas pelas listas de candidatos não acham melhora
+    bool best_exact_add(int& in) const {
+        double best = -1e-9 * std::max(1.0, std::abs(cost_));
+        bool found = false;
+        for (int i = 0; i < instance_.n; ++i) {
+            if (open_[i])
+                continue;
+            double delta = instance_.fixed[i] + reduced_sum(instance_.row(i), best_cost_.data(), instance_.m);
+            if (delta < best) {
+                best = delta;
+                in = i;
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    // Aplica o movimento e atualiza só os clientes cujo b1 ou b2 muda
+    void apply(int in, int out) {
+        int m = instance_.m;
+        if (in >= 0) {
+            open_facility(in);
+            cost_ += instance_.fixed[in];
+        }
+        if (out >= 0) {
+            close_facility(out);
+            cost_ -= instance_.fixed[out];
+        }
+        const double* c = in >= 0 ? instance_.row(in) : nullptr;
+        for (int j = 0; j < m; ++j) {
+            bool lost = out >= 0 && (best_[j] == out || second_[j] == out);
+            bool gained = in >= 0 && c[j] < second_cost_[j];
+            if (!lost && !gained)
+                continue;
+            contribute(j, -1);
+            cost_ -= best_cost_[j];
+            if (lost) {
+                reassign(j);
+            } else if (c[j] < best_cost_[j]) {
+                second_[j] = best_[j], second_cost_[j] = best_cost_[j];
+                best_[j] = in, best_cost_[j] = c[j];
+            } else {
+                second_[j] = in, second_cost_[j] = c[j];
+            }
+            cost_ += best_cost_[j];
+            contribute(j, 1);
+        }
+    }
+};
+
+// Relaxação lagrangiana das restrições de atendimento sum_i x[i][j] = 1 com
+// multiplicadores lambda[j]. O subproblema se separa por depósito: instalar
+// i vale g[i] = f[i] + sum_j min(0, c[i][j] - lambda[j]), e o limitante é
+// L(lambda) = sum_j lambda[j] + sum_i min(0, g[i]). Os depósitos são
+// divididos entre as threads, cada uma com seus acumuladores, somados no fim
+// de cada iteração. Os multiplicadores seguem o subgradiente
+// s[j] = 1 - (depósitos instalados com c[i][j] < lambda[j]) com o passo de
+// Polyak theta (UB - L) / |s|², e theta cai pela metade após 20 iterações
+// sem melhora do limitante. A heurística primal instala os depósitos da
+// solução lagrangiana (ou o de menor g, se nenhum), sempre que esse conjunto
+// muda, e atende cada cliente pelo mais barato deles. Quando isso melhora a
+// melhor solução da heurística, o conjunto é refinado pela busca local, e a
+// solução refinada dá o UB do passo e a solução devolvida, sem os depósitos
+// que ficaram sem clientes
+class LagrangianFacilities {
+public:
+    LagrangianFacilities(const FacilityInstance& instance, int threads, int neighbors = 16)
+        : instance_(instance), threads_(std::max(1, threads)), search_(instance, neighbors) {
+        // Em instâncias pequenas, criar threads custa mais que a iteração
+        if (size_t(instance.n) * instance.m < (size_t(1) << 18))
+            threads_ = 1;
+        threads_ = std::min(threads_, instance.n);
+    }
+
+    FacilityResult solve(int max_iterations, double time_limit) {
+        auto start = std::chrono::steady_clock::now();
+        int n = instance_.n, m = instance_.m;
+
+        // Multiplicadores iniciais: o menor custo de atendimento de cada cliente
+        std::vector<double> lambda(m, std::numeric_limits<double>::max());
+        for (int i = 0; i < n; ++i)
+            min_into(instance_.row(i), lambda.data(), m);
+
+        std::vector<double> g(n), count(m), subgradient(m), best(m);
+        std::vector<std::vector<double>> partial(threads_, std::vector<double>(m));
+        std::vector<char> open(n), best_open, last_open;
+        double lower = -std::numeric_limits<double>::infinity();
+        double upper = std::numeric_limits<double>::infinity();
+        double heuristic = upper;  // Melhor custo da heurística, antes da busca local
+        double theta = 2.0;
+        int stalled = 0;
+
+        FacilityResult result;
+        for (int k = 0; k < max_iterations; ++k) {
+            result.iterations = k + 1;
+
+            // Subproblemas por depósito e contagem dos clientes atribuídos
+            double value = 0;
+            for (int j = 0; j < m; ++j)
+                value += lambda[j];
+            parallel([&](int t, int begin, int end) {
+                std::fill(partial[t].begin(), partial[t].end(), 0.0);
+                for (int i = begin; i < end; ++i) {
+                    g[i] = instance_.fixed[i] + reduced_sum(instance_.row(i), lambda.data(), m);
+                    if (g[i] < 0)
+                        count_below(instance_.row(i), lambda.data(), partial[t].data(), m);
+                }
+            });
+            reduce(partial, count, [](double a, double b) { return a + b; });
+            int cheapest = 0;
+            bool any = false;
+            for (int i = 0; i < n; ++i) {
+                open[i] = g[i] < 0;
+                any = any || open[i];
+                value += std::min(0.0, g[i]);
+                if (g[i] < g[cheapest])
+                    cheapest = i;
+            }
+            if (value > lower) {
+                lower = value;
+                stalled = 0;
+            } else if (++stalled >= 20) {
+                theta /= 2;
+                stalled = 0;
+            }
+
+            // Heurística primal sobre os depósitos da solução lagrangiana
+            if (!any)
+                open[cheapest] = 1;
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (open != last_open) {
+                double candidate = evaluate(open, partial, best);
+                if (candidate < heuristic) {
+                    heuristic = candidate;
+                    if (candidate < upper) {
+                        upper = candidate;
+                        best_open = open;
+                    }
+                    // Sem tempo restante, a busca local devolve o próprio conjunto
+                    double remaining = time_limit > 0 ? std::max(time_limit - elapsed, 1e-9) : 0;
+                    FacilityResult local = search_.solve(remaining, open);
+                    if (local.cost < upper) {
+                        upper = local.cost;
+                        best_open = local.open;
+                    }
+                    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                }
+                last_open = open;
+            }
+
+            double norm = 0;
+            for (int j = 0; j < m; ++j) {
+                subgradient[j] = 1 - count[j];
+                norm += subgradient[j] * subgradient[j];
+            }
+            if (norm == 0 || upper - lower <= 1e-7 * std::max(1.0, std::abs(upper)) || theta < 1e-6 ||
+                (time_limit > 0 && elapsed >= time_limit))
+                break;
+
+            double step = theta * (upper - value) / norm;
+            for (int j = 0; j < m; ++j)
+                lambda[j] += step * subgradient[j];
+        }
+
+        finish(best_open, result);
+        result.bound = std::min(lower, result.cost);
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+private:
+    const FacilityInstance& instance_;
+    int threads_;
+    LocalSearchFacilities search_;
+
+    // Executa body(t, begin, end) para blocos contíguos de depósitos, um por
+    // thread, na thread atual se só houver uma
+    template <class Body>
+    void parallel(const Body& body) {
+        int n = instance_.n;
+        if (threads_ == 1)
+            return body(0, 0, n);
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads_; ++t)
+            pool.emplace_back(body, t, int(int64_t(n) * t / threads_), int(int64_t(n) * (t + 1) / threads_));
+        for (auto& thread : pool)
+            thread.join();
+    }
+
+    template <class Op>
+    void reduce(const std::vector<std::vector<double>>& partial, std::vector<double>& total, Op op) const {
+        total = partial[0];
+        for (int t = 1; t < threads_; ++t)
+            for (size_t j = 0; j < total.size(); ++j)
+                total[j] = op(total[j], partial[t][j]);
+    }
+
+    // Custo de instalar os depósitos de open e atender cada cliente pelo mais
+    // barato deles
+    double evaluate(const std::vector<char>& open, std::vector<std::vector<double>>& partial,
+                    std::vector<double>& best) {
+        parallel([&](int t, int begin, int end) {
+            std::fill(partial[t].begin(), partial[t].end(), std::numeric_limits<double>::infinity());
+            for (int i = begin; i < end; ++i)
+                if (open[i])
+                    min_into(instance_.row(i), partial[t].data(), instance_.m);
+        });
+        reduce(partial, best, [](double a, double b) { return std::min(a, b); });
+        double total = 0;
+        for (int i = 0; i < instance_.n; ++i)
+            if (open[i])
+                total += instance_.fixed[i];
+        for (double c : best)
+            total += c;
+        return total;
+    }
+
+    // Atribuição da melhor solução, sem os depósitos que ficaram vazios
+    void finish(const std::vector<char>& open, FacilityResult& result) const {
+        int n = instance_.n, m = instance_.m;
+        result.assignment.assign(m, -1);
+        std::vector<double> best(m, std::numeric_limits<double>::infinity());
+        for (int i = 0; i < n; ++i) {
+            if (!open[i])
+                continue;
+            const double* c = instance_.row(i);
+            for (int j = 0; j < m; ++j)
+                if (c[j] < best[j]) {
+                    best[j] = c[j];
+                    result.assignment[j] = i;
+                }
+        }
+        result.open.assign(n, 0);
+        result.cost = 0;
+        for (int j = 0; j < m; ++j) {
+            result.open[result.assignment[j]] = 1;
+            result.cost += best[j];
+        }
+        for (int i = 0; i < n; ++i)
+            if (result.open[i])
+                result.cost += instance_.fixed[i];
+    }
+};
+
+#endif
@@ -5,81 +5,191 @@
   Cada duto tem uma direção fixa e uma capacidade máxima de transporte.
 
   Objetivo: Maximizar o fluxo total que sai da origem s e chega ao destino d.
+
+  Uso: fluxo [--instancia arquivo.max] [--motor pr|dinic|cplex|comparar]
+
+  A rede é lida em formato DIMACS max-flow do arquivo ou da entrada padrão
+  (fluxo.max é o exemplo de 4 nós), e os nós da resposta usam a mesma
+  numeração, a partir de 1. O motor padrão é o push-relabel de fluxo.hpp;
+  dinic usa o algoritmo de Dinic; cplex resolve o modelo inteiro sobre a
+  lista de dutos e comparar executa os três e confere os valores.
+  Além do fluxo em cada duto, a saída traz os dutos do corte mínimo.
 */
 
 #include <ilcplex/ilocplex.h>
 #include <vector>
+#include <string>
 #include <iostream>
+#include <chrono>
+#include <cmath>
 
-ILOSTLBEGIN;
+#include "fluxo.hpp"
+#include "arc-index.hpp"
 
-// Representação do grafo: matriz de adjacência com capacidades
-const std::vector<std::vector<int>> GRAFO = {
-  {0, 10, 5, 0},   // s → {1,2}
-  {0, 0, 15, 8},   // 1 → {2,3}
-  {0, 0, 0, 10},   // 2 → 3
-  {0, 0, 0, 0}     // d
-};
+ILOSTLBEGIN;
 
-int main() {
+// Modelo inteiro sobre a lista de arcos, mantido como referência para
+// conferir os motores nativos: uma variável por duto e uma linha de
+// conservação por nó intermediário, montada dos índices de saída (CSR) e de
+// entrada (CSC) e adicionada em bloco. Retorna false se o CPLEX não resolveu
+// o problema
+bool solve_cplex(const FlowNetwork& network, std::vector<int64_t>& flows) {
   IloEnv env;
   IloModel model(env);
 
-  int n = GRAFO.size();
-  int s = 0; // origem (source)
-  int d = 3; // destino (sink)
+  int n = network.n;
+  int s = network.source; // origem (source)
+  int d = network.sink;   // destino (sink)
+  size_t m = network.arcs.size();
 
-  // Variáveis de decisão: x[i][j] representa o fluxo do nó i para o nó j
-  IloArray<IloNumVarArray> x(env, n);
-  for (int i = 0; i < n; ++i) {
-    x[i] = IloNumVarArray(env, n);
-    for (int j = 0; j < n; ++j) {
-      // Fluxo máximo limitado pela capacidade do duto
-      x[i][j] = IloIntVar(env, 0, GRAFO[i][j]);
-    }
+  // Arcos que saem e que chegam em cada nó
+  ArcIndex out(n, m, [&](size_t k) { return network.arcs[k].from; });
+  ArcIndex in(n, m, [&](size_t k) { return network.arcs[k].to; });
+
+  // Variáveis de decisão: x[k] representa o fluxo no duto k
+  IloNumVarArray x(env, m);
+  for (size_t k = 0; k < m; ++k) {
+    // Fluxo máximo limitado pela capacidade do duto
+    x[k] = IloIntVar(env, 0, double(network.arcs[k].capacity));
   }
 
-  // Função objetivo: maximizar o fluxo total saindo da origem (s)
+  // Função objetivo: maximizar o fluxo líquido saindo da origem (s)
   IloExpr fluxo_saida(env);
-  for (int j = 0; j < n; ++j)
-    fluxo_saida += x[s][j];
+  for (const size_t* k = out.begin(s); k != out.end(s); ++k)
+    fluxo_saida += x[*k];
+  for (const size_t* k = in.begin(s); k != in.end(s); ++k)
+    fluxo_saida -= x[*k];
 
   model.add(IloMaximize(env, fluxo_saida));
 
-  // Restrição de conservação de fluxo para nós intermediários (exceto s e d)
+  // Restrição de conservação de fluxo para nós intermediários (exceto s e d):
+  // fluxo que sai menos fluxo que entra igual a zero
+  IloRangeArray conservacao(env);
   for (int i = 0; i < n; ++i) {
     if (i == s || i == d) continue;
 
-    IloExpr entrada(env);
-    IloExpr saida(env);
-
-    for (int j = 0; j < n; ++j) {
-      entrada += x[j][i]; // fluxo entrando no nó i
-      saida += x[i][j];   // fluxo saindo do nó i
-    }
+    IloExpr saldo(env);
+    for (const size_t* k = out.begin(i); k != out.end(i); ++k)
+      saldo += x[*k]; // fluxo saindo do nó i
+    for (const size_t* k = in.begin(i); k != in.end(i); ++k)
+      saldo -= x[*k]; // fluxo entrando no nó i
 
-    model.add(entrada == saida); // fluxo que entra deve ser igual ao que sai
+    conservacao.add(IloRange(env, 0, saldo, 0));
+    saldo.end();
   }
+  model.add(conservacao);
 
   // Resolver o modelo
   IloCplex cplex(model);
-  if (!cplex.solve()) {
-    std::cout << "Problema não resolvido.\n";
+  cplex.setOut(env.getNullStream());
+  bool solved = cplex.solve();
+
+  if (solved) {
+    flows.assign(m, 0);
+    for (size_t k = 0; k < m; ++k)
+      flows[k] = std::llround(cplex.getValue(x[k]));
+  }
+
+  env.end();
+  return solved;
+}
+
+// Executa um motor nativo num grafo residual novo; retorna o valor do fluxo
+template <class Engine>
+int64_t solve_native(const FlowNetwork& network, ResidualGraph& graph, const char* name) {
+  auto start = std::chrono::steady_clock::now();
+  int64_t value = Engine(graph).solve(network.source, network.sink);
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << name << ": fluxo " << value << " em " << seconds << " s\n";
+  return value;
+}
+
+int main(int argc, char* argv[]) {
+  std::string path = "-";
+  std::string engine = "pr";
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (std::string(argv[i]) == "--instancia")
+      path = argv[++i];
+    else if (std::string(argv[i]) == "--motor")
+      engine = argv[++i];
+  }
+  if (engine != "pr" && engine != "dinic" && engine != "cplex" && engine != "comparar") {
+    std::cerr << "Motor desconhecido: " << engine << "\n";
+    return 1;
+  }
+
+  FlowNetwork network;
+  try {
+    network = load_dimacs_flow(path);
+  } catch (const std::exception& e) {
+    std::cerr << "Erro na leitura da instância: " << e.what() << "\n";
     return 1;
   }
 
+  ResidualGraph graph(network);
+  int64_t value = 0;
+  if (engine == "pr" || engine == "comparar")
+    value = solve_native<PushRelabel>(network, graph, "Push-relabel");
+  if (engine == "dinic" || engine == "comparar") {
+    ResidualGraph other(network);
+    int64_t dinic = solve_native<Dinic>(network, other, "Dinic");
+    if (engine == "dinic")
+      graph = std::move(other);
+    else if (dinic != value) {
+      std::cout << "Divergência entre o push-relabel (" << value << ") e o Dinic (" << dinic << ")!\n";
+      return 1;
+    }
+    value = dinic;
+  }
+  if (engine == "cplex" || engine == "comparar") {
+    std::vector<int64_t> flows;
+    if (!solve_cplex(network, flows)) {
+      std::cout << "Problema não resolvido.\n";
+      return 1;
+    }
+    int64_t reference = 0;
+    for (size_t k = 0; k < network.arcs.size(); ++k) {
+      if (network.arcs[k].from == network.source)
+        reference += flows[k];
+      if (network.arcs[k].to == network.source)
+        reference -= flows[k];
+    }
+    if (engine == "comparar") {
+      std::cout << "CPLEX: fluxo " << reference << "\n";
+      if (reference != value) {
+        std::cout << "Divergência entre os motores nativos (" << value << ") e o CPLEX (" << reference << ")!\n";
+        return 1;
+      }
+      std::cout << "Valores conferem\n";
+    } else {
+      graph.assign(flows);
+      value = reference;
+    }
+  }
+
   std::cout << "Problema resolvido!\n";
-  std::cout << "Fluxo máximo: " << cplex.getObjValue() << "\n\n";
+  std::cout << "Fluxo máximo: " << value << "\n\n";
 
   // Exibir valores de fluxo utilizados nas arestas
-  for (int i = 0; i < n; ++i) {
-    for (int j = 0; j < n; ++j) {
-      double val = cplex.getValue(x[i][j]);
-      if (val > 0)
-        std::cout << "Fluxo de " << i << " → " << j << ": " << val << "\n";
-    }
+  for (size_t k = 0; k < network.arcs.size(); ++k) {
+    int64_t val = graph.flow(k);
+    if (val > 0)
+      std::cout << "Fluxo de " << network.arcs[k].from + 1 << " → " << network.arcs[k].to + 1 << ": " << val << "\n";
   }
 
-  env.end();
+  // Corte mínimo: dutos que saem do lado da origem, todos saturados
+  std::vector<char> side = graph.source_side(network.source);
+  int64_t cut = 0;
+  size_t count = 0;
+  for (const FlowArc& arc : network.arcs)
+    if (side[arc.from] && !side[arc.to]) {
+      cut += arc.capacity;
+      ++count;
+    }
+  std::cout << "\nCorte mínimo: " << count << " dutos, capacidade " << cut << "\n";
+  for (const FlowArc& arc : network.arcs)
+    if (side[arc.from] && !side[arc.to])
+      std::cout << "Duto " << arc.from + 1 << " → " << arc.to + 1 << ": capacidade " << arc.capacity << "\n";
+
   return 0;
 }
@@ -0,0 +1,421 @@
+/*
+  Fluxo máximo em redes DIMACS: push-relabel pelo maior rótulo, com
+  reetiquetagem global e heurística do gap, e Dinic como alternativa, ambos
+  sobre o mesmo grafo residual em CSR. Terminado o fluxo, o grafo residual
+  também dá o lado da origem no corte mínimo.
+
+  Formato da instância: DIMACS max-flow, com linhas "c comentário",
+  "p max n m", "n id s" (origem), "n id t" (destino) e "a u v capacidade",
+  nós numerados a partir de 1.
+*/
+
+#ifndef FLUXO_HPP
+#define FLUXO_HPP
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include <limits>
+#include <cstdint>
+
+#include "input-file.hpp"
+
+struct FlowArc {
+    int from, to;  // nós a partir de 0
+    int64_t capacity;
+};
+
+struct FlowNetwork {
+    int n = 0;
+    int source = -1, sink = -1;
+    std::vector<FlowArc> arcs;
+};
+
+// Lê uma rede DIMACS de path ("-" é a entrada padrão)
+inline FlowNetwork load_dimacs_flow(const std::string& path) {
+    InputFile input(path);
+    std::istream& in = input.stream();
+
+    FlowNetwork network;
+    bool header = false;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        char kind;
+        if (!(fields >> kind) || kind == 'c')
+            continue;
+        if (kind == 'p') {
+            std::string format;
+            long long m;
+            if (!(fields >> format >> network.n >> m) || network.n < 2 || m < 0)
+                throw std::runtime_error("linha \"p\" inválida: " + line);
+            network.arcs.reserve(m);
+            header = true;
+        } else if (!header) {
+            throw std::runtime_error("linha antes de \"p max n m\": " + line);
+        } else if (kind == 'n') {
+            int v;
+            char role;
+            if (!(fields >> v >> role) || v < 1 || v > network.n || (role != 's' && role != 't'))
+                throw std::runtime_error("linha \"n\" inválida: " + line);
+            (role == 's' ? network.source : network.sink) = v - 1;
+        } else if (kind == 'a') {
+            int u, v;
+            long long capacity;
+            if (!(fields >> u >> v >> capacity) || u < 1 || v < 1 || u > network.n || v > network.n || capacity < 0)
+                throw std::runtime_error("arco inválido: " + line);
+            if (u != v)
+                network.arcs.push_back({u - 1, v - 1, capacity});
+        }
+    }
+    if (!header)
+        throw std::runtime_error("linha \"p max n m\" não encontrada");
+    if (network.source < 0 || network.sink < 0 || network.source == network.sink)
+        throw std::runtime_error("origem e destino distintos são obrigatórios");
+    return network;
+}
+
+// Grafo residual em CSR: os arcos que saem de v ocupam [first(v), first(v+1))
+// e cada arco da rede gera o par direto/reverso, ligados por reverse(). Os
+// arcos de um nó ficam contíguos, e os percursos dos algoritmos leem só
+// head_ e residual_ em sequência
+class ResidualGraph {
+public:
+    using Arc = uint32_t;
+
+    explicit ResidualGraph(const FlowNetwork& network)
+        : n_(network.n), first_(network.n + 1, 0), capacity_(network.arcs.size()), position_(network.arcs.size()) {
+        if (2 * network.arcs.size() >= std::numeric_limits<Arc>::max())
+            throw std::runtime_error("arcos demais para o grafo residual");
+        for (const FlowArc& arc : network.arcs) {
+            ++first_[arc.from + 1];
+            ++first_[arc.to + 1];
+        }
+        for (int v = 0; v < n_; ++v)
+            first_[v + 1] += first_[v];
+
+        size_t arcs = first_[n_];
+        head_.resize(arcs);
+        residual_.resize(arcs);
+        reverse_.resize(arcs);
+        std::vector<Arc> next(first_.begin(), first_.end() - 1);
+        for (size_t i = 0; i < network.arcs.size(); ++i) {
+            const FlowArc& arc = network.arcs[i];
+            Arc a = next[arc.from]++, b = next[arc.to]++;
+            head_[a] = arc.to;
+            head_[b] = arc.from;
+            residual_[a] = arc.capacity;
+            residual_[b] = 0;
+            reverse_[a] = b;
+            reverse_[b] = a;
+            capacity_[i] = arc.capacity;
+            position_[i] = a;
+        }
+    }
+
+    int size() const { return n_; }
+    Arc first(int v) const { return first_[v]; }
+    int head(Arc a) const { return head_[a]; }
+    Arc reverse(Arc a) const { return reverse_[a]; }
+    int64_t residual(Arc a) const { return residual_[a]; }
+
+    void push(Arc a, int64_t delta) {
+        residual_[a] -= delta;
+        residual_[reverse_[a]] += delta;
+    }
+
+    // Fluxo no arco i da rede
+    int64_t flow(size_t i) const { return capacity_[i] - residual_[position_[i]]; }
+
+    // Substitui o fluxo atual pelo fluxo dado em cada arco da rede
+    void assign(const std::vector<int64_t>& flows) {
+        for (size_t i = 0; i < flows.size(); ++i) {
+            Arc a = position_[i];
+            residual_[a] = capacity_[i] - flows[i];
+            residual_[reverse_[a]] = 0;
+        }
+        for (size_t i = 0; i < flows.size(); ++i)
+            residual_[reverse_[position_[i]]] += flows[i];
+    }
+
+    // Lado da origem do corte mínimo: nós alcançáveis a partir da origem por
+    // arcos com capacidade residual, válido para qualquer fluxo máximo
+    std::vector<char> source_side(int source) const {
+        std::vector<char> reached(n_, 0);
+        std::vector<int> queue(1, source);
+        reached[source] = 1;
+        for (size_t k = 0; k < queue.size(); ++k) {
+            int v = queue[k];
+            for (Arc a = first_[v]; a < first_[v + 1]; ++a)
+                if (residual_[a] > 0 && !reached[head_[a]]) {
+                    reached[head_[a]] = 1;
+                    queue.push_back(head_[a]);
+                }
+        }
+        return reached;
+    }
+
+private:
+    int n_;
+    std::vector<Arc> first_;
+    std::vector<int> head_;
+    std::vector<int64_t> residual_;
+    std::vector<Arc> reverse_;
+    std::vector<int64_t> capacity_;  // da rede, por arco original
+    std::vector<Arc> position_;      // arco direto de cada arco original
+};
+
+// Push-relabel pelo maior rótulo (Goldberg-Tarjan, na linha do hi_pr de
+// Cherkassky e Goldberg). A primeira fase leva ao destino todo o excesso que
+// consegue e já determina o valor do fluxo máximo; a segunda devolve à origem
+// o excesso que sobrou, para que o resultado seja um fluxo válido. Os nós
+// ativos ficam em listas por rótulo e todos os nós vivos em listas duplamente
+// ligadas por rótulo, o que permite a heurística do gap: se um rótulo g fica
+// vazio, nenhum nó acima dele alcança o alvo e todos são descartados. Os
+// rótulos são recalculados por uma busca em largura reversa a partir do alvo
+// no início e sempre que o trabalho de reetiquetagem passa de 6n + m
+class PushRelabel {
+public:
+    explicit PushRelabel(ResidualGraph& graph)
+        : graph_(graph), n_(graph.size()), label_(n_), excess_(n_, 0), current_(n_),
+          active_(n_ + 1), next_active_(n_), bucket_(n_ + 1), next_(n_), prev_(n_) {}
+
+    int64_t solve(int source, int sink) {
+        for (ResidualGraph::Arc a = graph_.first(source); a < graph_.first(source + 1); ++a) {
+            int64_t delta = graph_.residual(a);
+            if (delta > 0) {
+                graph_.push(a, delta);
+                excess_[graph_.head(a)] += delta;
+                excess_[source] -= delta;
+            }
+        }
+        discharge_all(sink, source);
+        int64_t value = excess_[sink];
+        discharge_all(source, sink);
+        return value;
+    }
+
+private:
+    static constexpr int NONE = -1;
+
+    ResidualGraph& graph_;
+    int n_;
+    std::vector<int> label_;
+    std::vector<int64_t> excess_;
+    std::vector<ResidualGraph::Arc> current_;
+    std::vector<int> active_, next_active_;      // nós ativos por rótulo
+    std::vector<int> bucket_, next_, prev_;      // nós vivos por rótulo
+    int max_active_ = NONE, max_label_ = 0;
+    int64_t work_ = 0;
+
+    void add_active(int v) {
+        next_active_[v] = active_[label_[v]];
+        active_[label_[v]] = v;
+        max_active_ = std::max(max_active_, label_[v]);
+    }
+
+    void add_bucket(int v) {
+        int l = label_[v];
+        prev_[v] = NONE;
+        next_[v] = bucket_[l];
+        if (bucket_[l] != NONE)
+            prev_[bucket_[l]] = v;
+        bucket_[l] = v;
+        max_label_ = std::max(max_label_, l);
+    }
+
+    void remove_bucket(int v) {
+        if (prev_[v] != NONE)
+            next_[prev_[v]] = next_[v];
+        else
+            bucket_[label_[v]] = next_[v];
+        if (next_[v] != NONE)
+            prev_[next_[v]] = prev_[v];
+    }
+
+    // Rótulos exatos: distância até target no grafo residual; excluded (a
+    // origem na primeira fase, o destino na segunda) e os nós que não
+    // alcançam target ficam com rótulo n, fora da busca
+    void global_relabel(int target, int excluded) {
+        std::fill(label_.begin(), label_.end(), n_);
+        std::fill(active_.begin(), active_.end(), NONE);
+        std::fill(bucket_.begin(), bucket_.end(), NONE);
+        max_active_ = NONE;
+        max_label_ = 0;
+        work_ = 0;
+
+        std::vector<int> queue(1, target);
+        label_[target] = 0;
+        for (size_t k = 0; k < queue.size(); ++k) {
+            int v = queue[k];
+            for (ResidualGraph::Arc a = graph_.first(v); a < graph_.first(v + 1); ++a) {
+                int u = graph_.head(a);
+                if (label_[u] == n_ && u != excluded && graph_.residual(graph_.reverse(a)) > 0) {
+                    label_[u] = label_[v] + 1;
+                    queue.push_back(u);
+                }
+            }
+        }
+        for (int v : queue) {
+            current_[v] = graph_.first(v);
+            add_bucket(v);
+            if (excess_[v] > 0 && v != target)
+                add_active(v);
+        }
+    }
+
+    // Todos os nós vivos com rótulo acima de gap deixam de alcançar o alvo
+    void remove_above(int gap) {
+        for (int l = gap + 1; l <= max_label_; ++l) {
+            for (int v = bucket_[l]; v != NONE; v = next_[v])
+                label_[v] = n_;
+            bucket_[l] = NONE;
+        }
+        max_label_ = gap - 1;
+    }
+
+    void relabel(int v) {
+        int old = label_[v];
+        remove_bucket(v);
+        if (bucket_[old] == NONE && old < max_label_ + 1) {
+            remove_above(old);
+            label_[v] = n_;
+            return;
+        }
+
+        int lowest = n_;
+        ResidualGraph::Arc end = graph_.first(v + 1);
+        for (ResidualGraph::Arc a = graph_.first(v); a < end; ++a)
+            if (graph_.residual(a) > 0 && label_[graph_.head(a)] + 1 < lowest) {
+                lowest = label_[graph_.head(a)] + 1;
+                current_[v] = a;
+            }
+        work_ += 12 + (end - graph_.first(v));
+        label_[v] = lowest;
+        if (lowest < n_)
+            add_bucket(v);
+    }
+
+    void discharge(int v, int target) {
+        ResidualGraph::Arc end = graph_.first(v + 1);
+        while (excess_[v] > 0) {
+            for (ResidualGraph::Arc& a = current_[v]; a < end; ++a) {
+                int u = graph_.head(a);
+                if (graph_.residual(a) == 0 || label_[u] + 1 != label_[v])
+                    continue;
+                int64_t delta = std::min(excess_[v], graph_.residual(a));
+                graph_.push(a, delta);
+                if (excess_[u] == 0 && u != target)
+                    add_active(u);
+                excess_[u] += delta;
+                excess_[v] -= delta;
+                if (excess_[v] == 0)
+                    return;
+            }
+            relabel(v);
+            if (label_[v] >= n_)
+                return;
+        }
+    }
+
+    // Descarrega os nós ativos, sempre o de maior rótulo, até que nenhum
+    // excesso consiga chegar a target
+    void discharge_all(int target, int excluded) {
+        global_relabel(target, excluded);
+        int64_t frequency = 6 * int64_t(n_) + graph_.first(n_);
+        while (max_active_ != NONE) {
+            int v = active_[max_active_];
+            if (v == NONE) {
+                --max_active_;
+                continue;
+            }
+            active_[max_active_] = next_active_[v];
+            if (label_[v] >= n_)
+                continue;
+            discharge(v, target);
+            if (work_ > frequency)
+                global_relabel(target, excluded);
+        }
+    }
+};
+
+// Dinic: fases de busca em largura a partir da origem, seguidas de um fluxo
+// bloqueante no grafo de níveis por busca em profundidade iterativa, com
+// ponteiro de arco corrente por nó (sem recursão, para redes longas)
+class Dinic {
+public:
+    explicit Dinic(ResidualGraph& graph)
+        : graph_(graph), n_(graph.size()), level_(n_), current_(n_) {}
+
+    int64_t solve(int source, int sink) {
+        int64_t value = 0;
+        std::vector<ResidualGraph::Arc> path;
+        while (levels(source, sink)) {
+            for (int v = 0; v < n_; ++v)
+                current_[v] = graph_.first(v);
+            path.clear();
+            int v = source;
+            while (true) {
+                if (v == sink) {
+                    int64_t delta = std::numeric_limits<int64_t>::max();
+                    for (ResidualGraph::Arc a : path)
+                        delta = std::min(delta, graph_.residual(a));
+                    size_t cut = path.size();
+                    for (size_t k = path.size(); k-- > 0;) {
+                        graph_.push(path[k], delta);
+                        if (graph_.residual(path[k]) == 0)
+                            cut = k;
+                    }
+                    value += delta;
+                    path.resize(cut);
+                    v = cut == 0 ? source : graph_.head(path.back());
+                    continue;
+                }
+
+                ResidualGraph::Arc end = graph_.first(v + 1);
+                ResidualGraph::Arc& a = current_[v];
+                while (a < end && (graph_.residual(a) == 0 || level_[graph_.head(a)] != level_[v] + 1))
+                    ++a;
+                if (a < end) {
+                    path.push_back(a);
+                    v = graph_.head(a);
+                } else if (path.empty()) {
+                    break;
+                } else {
+                    level_[v] = -1;  // sem caminho até o destino nesta fase
+                    ResidualGraph::Arc back = path.back();
+                    path.pop_back();
+                    v = graph_.head(graph_.reverse(back));
+                    ++current_[v];
+                }
+            }
+        }
+        return value;
+    }
+
+private:
+    ResidualGraph& graph_;
+    int n_;
+    std::vector<int> level_;
+    std::vector<ResidualGraph::Arc> current_;
+
+    bool levels(int source, int sink) {
+        std::fill(level_.begin(), level_.end(), -1);
+        std::vector<int> queue(1, source);
+        level_[source] = 0;
+        for (size_t k = 0; k < queue.size() && level_[sink] < 0; ++k) {
+            int v = queue[k];
+            for (ResidualGraph::Arc a = graph_.first(v); a < graph_.first(v + 1); ++a)
+                if (graph_.residual(a) > 0 && level_[graph_.head(a)] < 0) {
+                    level_[graph_.head(a)] = level_[v] + 1;
+                    queue.push_back(graph_.head(a));
+                }
+        }
+        return level_[sink] >= 0;
+    }
+};
+
+#endif
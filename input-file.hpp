@@ -0,0 +1,30 @@
+/*
+  Entrada das instâncias dos programas com motores próprios: o arquivo
+  indicado na linha de comando ou, com o caminho "-", a entrada padrão.
+*/
+
+#ifndef INPUT_FILE_HPP
+#define INPUT_FILE_HPP
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+class InputFile {
+public:
+    explicit InputFile(const std::string& path) {
+        if (path == "-")
+            return;
+        file_.open(path);
+        if (!file_)
+            throw std::runtime_error("não foi possível abrir " + path);
+    }
+
+    std::istream& stream() { return file_.is_open() ? file_ : std::cin; }
+
+private:
+    std::ifstream file_;
+};
+
+#endif
@@ -1,27 +1,35 @@
 /*
-– Dado um conjunto de n itens e um inteiro W que representa a capacidade da 
+– Dado um conjunto de n itens e um inteiro W que representa a capacidade da
 mochila.
-– Cada item i possui um valor vi e um peso wi. 
-– Determinar o subconjuntos de itens que maximizam o somatório dos valores 
+– Cada item i possui um valor vi e um peso wi.
+– Determinar o subconjuntos de itens que maximizam o somatório dos valores
 respeitando a capacidade de peso da mochila.
+
+Uso: knapsack [--instancia arquivo.dat] [--motor nucleo|pd|soma|cplex|comparar]
+
+A instância é lida do arquivo ou da entrada padrão (formato em knapsack.hpp;
+knapsack.dat é o exemplo de 20 itens). O motor padrão é o algoritmo exato
+por núcleo expandido; pd é a programação dinâmica com memória O(W), para
+capacidades pequenas; soma resolve o subset-sum, a maior soma de pesos que
+cabe, ignorando os valores; cplex resolve o modelo inteiro original e
+comparar executa o núcleo e o CPLEX e confere os valores ótimos.
 */
 
 #include <ilcplex/ilocplex.h>
 #include <vector>
+#include <string>
+#include <cmath>
+
+#include "knapsack.hpp"
 
 ILOSTLBEGIN;
 
-int main() {
+// Modelo inteiro original, mantido como referência para conferir o motor
+// nativo. Retorna false se o CPLEX não resolveu o problema
+bool solve_cplex(const KnapsackInstance& instance, KnapsackResult& result) {
     IloEnv env;
     IloModel model(env);
-
-    // Definição do número de itens (n) e a capacidade máxima da mochila (W)
-    int n = 20;  // Número de itens
-    int W = 878; // Capacidade máxima da mochila
-
-    // Vetores contendo o peso (w) e valor (v) de cada item
-    vector<double> w = {92, 4, 43, 83, 84, 68, 92, 82, 6, 44, 32, 18, 56, 83, 25, 96, 70, 48, 14, 58};
-    vector<double> v = {44, 46, 90, 72, 91, 40, 75, 35, 8, 54, 78, 40, 77, 15, 61, 17, 75, 29, 75, 63};
+    int n = instance.size();
 
     // Declaração das variáveis binárias x[i], que indicam se o item i é incluído na mochila
     IloIntVarArray x(env, n, 0, 1); // 0 ou 1, indicando a inclusão ou não do item na solução
@@ -29,7 +37,7 @@ int main() {
     // Função Objetivo: Maximizar o valor total dos itens incluídos na mochila
     IloExpr somatorioObj(env);
     for (int i = 0; i < n; ++i) {
-        somatorioObj += v[i] * x[i];  // Cada valor dos itens é multiplicado pela sua variável binária
+        somatorioObj += double(instance.values[i]) * x[i];  // Cada valor dos itens é multiplicado pela sua variável binária
     }
 
     // Define a função objetivo no modelo
@@ -39,33 +47,100 @@ int main() {
     // Restrição de capacidade: a soma dos pesos dos itens selecionados não pode ultrapassar a capacidade da mochila
     IloExpr somatorioRes(env);
     for (int i = 0; i < n; ++i) {
-        somatorioRes += w[i] * x[i];  // Cada peso dos itens é multiplicado pela sua variável binária
+        somatorioRes += double(instance.weights[i]) * x[i];  // Cada peso dos itens é multiplicado pela sua variável binária
     }
-    model.add(somatorioRes <= W);  // Restrição de capacidade da mochila
+    model.add(somatorioRes <= double(instance.capacity));  // Restrição de capacidade da mochila
 
     // Resolver o modelo usando o solver CPLEX
     IloCplex cplex(model);
-    IloBool result = cplex.solve();  // Resolve o modelo otimizado
+    cplex.setOut(env.getNullStream());
+    IloBool solved = cplex.solve();
+
+    if (solved) {
+        result.value = std::llround(cplex.getObjValue());
+        result.weight = 0;
+        result.chosen.clear();
+        for (int i = 0; i < n; ++i) {
+            if (cplex.getValue(x[i]) > 0.5) { // Verifica se o item foi selecionado (x[i] == 1)
+                result.chosen.push_back(i);
+                result.weight += instance.weights[i];
+            }
+        }
+    }
+
+    env.end();
+    return solved;
+}
+
+int main(int argc, char* argv[]) {
+    std::string path = "-";
+    std::string engine = "nucleo";
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--instancia")
+            path = argv[++i];
+        else if (std::string(argv[i]) == "--motor")
+            engine = argv[++i];
+    }
+    if (engine != "nucleo" && engine != "pd" && engine != "soma" && engine != "cplex" && engine != "comparar") {
+        fprintf(stderr, "Motor desconhecido: %s\n", engine.c_str());
+        return 1;
+    }
+
+    KnapsackInstance instance;
+    try {
+        instance = load_knapsack(path);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "Erro na leitura da instância: %s\n", e.what());
+        return 1;
+    }
+
+    KnapsackResult result;
+    bool solved = true;
+    if (engine == "pd" || engine == "soma") {
+        try {
+            result = DpKnapsack(instance, engine == "soma").solve(instance);
+        } catch (const std::exception& e) {
+            fprintf(stderr, "%s\n", e.what());
+            return 1;
+        }
+        if (engine == "soma")
+            printf("Soma ótima dos pesos: %lld\n", (long long)result.weight);
+    } else if (engine != "cplex") {
+        result = CoreKnapsack(instance).solve();
+        printf("Limitante de Dantzig: %lld (núcleo com %zu itens, até %zu estados)\n",
+               (long long)result.bound, result.core, result.states);
+    }
+    if (engine == "cplex" || engine == "comparar") {
+        KnapsackResult reference;
+        solved = solve_cplex(instance, reference);
+        if (engine == "comparar" && solved) {
+            printf("Valor ótimo do CPLEX: %lld\n", (long long)reference.value);
+            if (reference.value != result.value) {
+                printf("Divergência entre o motor nativo (%lld) e o CPLEX (%lld)!\n",
+                       (long long)result.value, (long long)reference.value);
+                return 1;
+            }
+            printf("Valores ótimos conferem\n");
+        } else {
+            result = reference;
+        }
+    }
 
     // Exibe se o problema foi resolvido ou não
-    result ? printf("Problema resolvido!\n") : printf("Problema não resolvido\n");
+    solved ? printf("Problema resolvido!\n") : printf("Problema não resolvido\n");
+    if (!solved)
+        return 1;
 
     // Exibe o valor ótimo da função objetivo (valor máximo dos itens selecionados)
-    printf("Valor ótimo: %.2f\n", cplex.getObjValue());
+    printf("Valor ótimo: %.2f\n", double(result.value));
 
     // Exibe os itens que foram selecionados na solução ótima, juntamente com seus valores e pesos
     printf("Itens selecionados:\n");
-
-    float pesoTotal = 0.0;
-    for (int i = 0; i < n; ++i) {
-        if (cplex.getValue(x[i]) > 0) { // Verifica se o item foi selecionado (x[i] == 1)
-            printf("Item %d - valor: %.2f, peso: %.2f\n", i, v[i], w[i]);
-            pesoTotal += w[i];  // Atualiza o peso total dos itens selecionados
-        }
-    }
+    for (size_t i : result.chosen)
+        printf("Item %zu - valor: %.2f, peso: %.2f\n", i, double(instance.values[i]), double(instance.weights[i]));
 
     // Exibe o peso total dos itens selecionados
-    printf("Peso total: %.2f\n", pesoTotal);
+    printf("Peso total: %.2f\n", double(result.weight));
 
     return 0;
 }
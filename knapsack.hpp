@@ -0,0 +1,532 @@
+/*
+  Mochila 0-1 com dois motores. O núcleo expandido (CoreKnapsack) serve para
+  qualquer capacidade: parte da solução gulosa por eficiência e só enumera
+  os itens em torno do item de quebra. A programação dinâmica com memória
+  O(W) (DpKnapsack) fica para capacidades pequenas, com as linhas de valores
+  em SIMD ou, no subset-sum, conjuntos de somas em bits.
+
+  Formato da instância (.dat): "capacidade n" seguido de n pares
+  "peso valor", todos inteiros não negativos.
+*/
+
+#ifndef KNAPSACK_HPP
+#define KNAPSACK_HPP
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <numeric>
+#include <iostream>
+#include <stdexcept>
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define KNAPSACK_X86
+#endif
+
+#include "input-file.hpp"
+
+struct KnapsackInstance {
+    int64_t capacity = 0;
+    std::vector<int64_t> weights;
+    std::vector<int64_t> values;
+
+    size_t size() const { return weights.size(); }
+};
+
+struct KnapsackResult {
+    int64_t value = 0;
+    int64_t weight = 0;
+    std::vector<size_t> chosen;  // índices originais, em ordem crescente
+    int64_t bound = 0;           // limitante de Dantzig da relaxação linear
+    size_t core = 0;             // itens do núcleo expandido
+    size_t states = 0;           // maior lista de estados mantida
+};
+
+// Lê a instância de path ("-" é a entrada padrão)
+inline KnapsackInstance load_knapsack(const std::string& path) {
+    InputFile input(path);
+    std::istream& in = input.stream();
+
+    KnapsackInstance instance;
+    int64_t n;
+    if (!(in >> instance.capacity >> n) || instance.capacity < 0 || n < 0)
+        throw std::runtime_error("cabeçalho inválido: esperado \"capacidade n\"");
+    instance.weights.resize(n);
+    instance.values.resize(n);
+    for (int64_t i = 0; i < n; ++i) {
+        if (!(in >> instance.weights[i] >> instance.values[i]))
+            throw std::runtime_error("entrada terminou antes do item " + std::to_string(i));
+        if (instance.weights[i] < 0 || instance.values[i] < 0)
+            throw std::runtime_error("peso ou valor negativo no item " + std::to_string(i));
+    }
+    return instance;
+}
+
+// Mochila exata por núcleo expandido (no estilo do minknap de Pisinger).
+// Os itens são ordenados por eficiência valor/peso; a solução gulosa até o
+// item de quebra b dá o limitante de Dantzig. O núcleo começa vazio em b e
+// cresce um item de cada lado por vez: à direita, itens que podem entrar; à
+// esquerda, itens da solução gulosa que podem sair. Os estados (peso, valor)
+// das decisões no núcleo ficam numa lista ordenada por peso, sem dominados,
+// e cada estado é descartado quando nem a relaxação linear do que está fora
+// do núcleo o leva além da incumbente. Quando a lista esvazia, a incumbente
+// é ótima; em instâncias grandes isso acontece com o núcleo pequeno
+class CoreKnapsack {
+public:
+    explicit CoreKnapsack(const KnapsackInstance& instance) : capacity_(instance.capacity) {
+        // Itens de peso zero sempre entram; itens sem valor ou que não cabem
+        // sozinhos nunca entram. A ordenação é feita sobre cópias contíguas,
+        // sem acesso indireto aos vetores da instância
+        struct Item {
+            int64_t w, p;
+            size_t index;
+        };
+        std::vector<Item> items;
+        for (size_t i = 0; i < instance.size(); ++i) {
+            if (instance.weights[i] == 0) {
+                free_.push_back(i);
+                free_value_ += instance.values[i];
+            } else if (instance.values[i] > 0 && instance.weights[i] <= capacity_) {
+                items.push_back({instance.weights[i], instance.values[i], i});
+            }
+        }
+        std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+            __int128 lhs = __int128(a.p) * b.w, rhs = __int128(b.p) * a.w;
+            return lhs != rhs ? lhs > rhs : a.index < b.index;
+        });
+        for (const Item& item : items) {
+            w_.push_back(item.w);
+            p_.push_back(item.p);
+            order_.push_back(item.index);
+        }
+    }
+
+    KnapsackResult solve() {
+        size_t n = order_.size();
+        int64_t weight = 0, value = 0;
+        size_t b = 0;
+        while (b < n && weight + w_[b] <= capacity_) {
+            weight += w_[b];
+            value += p_[b];
+            ++b;
+        }
+
+        KnapsackResult result;
+        result.bound = free_value_ + value + (b < n ? int64_t(__int128(capacity_ - weight) * p_[b] / w_[b]) : 0);
+
+        // A solução gulosa é o único estado inicial; a incumbente inicial é
+        // ela completada com os itens depois da quebra que ainda cabem
+        best_ = value;
+        best_node_ = NONE;
+        for (size_t k = b, left = capacity_ - weight; k < n; ++k)
+            if (w_[k] <= int64_t(left)) {
+                left -= w_[k];
+                best_ += p_[k];
+                nodes_.push_back({best_node_, k});
+                best_node_ = nodes_.size() - 1;
+            }
+        states_ = {{weight, value, NONE}};
+        size_t s = b, t = b;
+        bool right = true;
+
+        // Redução de Dembo e Hammer: trocar o item k de lado na solução
+        // gulosa rende no máximo o limitante abaixo (a folga ou o excesso
+        // é compensado à eficiência do item de quebra). Se ele não supera a
+        // incumbente, o item fica fixo e entra no núcleo sem expandir a lista
+        auto fixed = [&](size_t k) {
+            if (b == n)
+                return true;
+            int64_t sign = k < b ? -1 : 1;
+            __int128 gain = __int128(value + sign * p_[k] - best_) * w_[b];
+            return gain + __int128(capacity_ - weight - sign * w_[k]) * p_[b] < __int128(w_[b]);
+        };
+
+        prune(s, t);
+        while (!states_.empty() && (s > 0 || t < n)) {
+            if ((right && t < n) || s == 0) {
+                if (!fixed(t))
+                    expand(t, +1);
+                ++t;
+            } else {
+                if (!fixed(--s))
+                    expand(s, -1);
+            }
+            right = !right;
+            prune(s, t);
+            result.states = std::max(result.states, states_.size());
+        }
+        result.core = t - s;
+
+        // Solução gulosa com as trocas registradas no histórico da incumbente
+        std::vector<char> in(n, 0);
+        std::fill(in.begin(), in.begin() + b, 1);
+        for (size_t node = best_node_; node != NONE; node = nodes_[node].parent)
+            in[nodes_[node].item] ^= 1;
+
+        result.chosen = free_;
+        for (size_t k = 0; k < n; ++k)
+            if (in[k]) {
+                result.chosen.push_back(order_[k]);
+                result.weight += w_[k];
+            }
+        std::sort(result.chosen.begin(), result.chosen.end());
+        result.value = best_ + free_value_;
+        return result;
+    }
+
+private:
+    static constexpr size_t NONE = SIZE_MAX;
+
+    struct State {
+        int64_t w, p;
+        size_t node;  // última troca no histórico; NONE é a solução gulosa
+    };
+
+    // Histórico compartilhado das trocas: cada estado aponta para a sua
+    // última, que aponta para a anterior, até a solução gulosa
+    struct Node {
+        size_t parent;
+        size_t item;  // posição na ordem por eficiência
+    };
+
+    int64_t capacity_;
+    std::vector<size_t> order_, free_;
+    int64_t free_value_ = 0;
+    std::vector<int64_t> w_, p_;
+
+    std::vector<State> states_, merged_;
+    std::vector<Node> nodes_;
+    size_t compact_at_ = 1 << 20;
+    int64_t best_;
+    size_t best_node_;
+
+    // Junta a lista com a sua cópia em que o item k troca de lado (sign = +1
+    // entra, -1 sai), mantendo só os estados não dominados: em ordem de
+    // peso, cada estado precisa valer mais que todos os mais leves
+    void expand(size_t k, int sign) {
+        int64_t dw = sign * w_[k], dp = sign * p_[k];
+        merged_.clear();
+        size_t i = 0, j = 0, m = states_.size();
+        while (i < m || j < m) {
+            bool shifted;
+            if (i == m)
+                shifted = true;
+            else if (j == m)
+                shifted = false;
+            else {
+                int64_t wi = states_[i].w, wj = states_[j].w + dw;
+                shifted = wj < wi || (wj == wi && states_[j].p + dp > states_[i].p);
+            }
+
+            const State& from = shifted ? states_[j++] : states_[i++];
+            int64_t w = shifted ? from.w + dw : from.w, p = shifted ? from.p + dp : from.p;
+            if (!merged_.empty() && p <= merged_.back().p)
+                continue;
+            size_t node = from.node;
+            if (shifted) {
+                node = nodes_.size();
+                nodes_.push_back({from.node, k});
+            }
+            merged_.push_back({w, p, node});
+        }
+        states_.swap(merged_);
+    }
+
+    // Atualiza a incumbente e descarta os estados que não podem superá-la.
+    // Fora do núcleo [s, t), só podem entrar itens de eficiência até a do
+    // item t e só podem sair itens de eficiência ao menos a do item s - 1,
+    // o que limita o ganho de um estado leve e a perda de um pesado
+    void prune(size_t s, size_t t) {
+        for (const State& state : states_)
+            if (state.w <= capacity_ && state.p > best_) {
+                best_ = state.p;
+                best_node_ = state.node;
+            }
+
+        size_t n = order_.size();
+        auto keep = [&](const State& state) {
+            if (state.w <= capacity_)
+                return t < n && __int128(capacity_ - state.w) * p_[t] >= __int128(best_ + 1 - state.p) * w_[t];
+            return s > 0 && __int128(state.p - best_ - 1) * w_[s - 1] >= __int128(state.w - capacity_) * p_[s - 1];
+        };
+        states_.erase(std::remove_if(states_.begin(), states_.end(), [&](const State& state) { return !keep(state); }),
+                      states_.end());
+
+        if (nodes_.size() >= compact_at_)
+            compact();
+    }
+
+    // Descarta do histórico as trocas que nenhum estado vivo alcança
+    void compact() {
+        std::vector<size_t> index(nodes_.size(), NONE);
+        auto mark = [&](size_t node) {
+            for (; node != NONE && index[node] == NONE; node = nodes_[node].parent)
+                index[node] = 0;
+        };
+        mark(best_node_);
+        for (const State& state : states_)
+            mark(state.node);
+
+        size_t kept = 0;
+        for (size_t node = 0; node < nodes_.size(); ++node)
+            if (index[node] != NONE)
+                index[node] = kept++;
+        for (size_t node = 0; node < nodes_.size(); ++node)
+            if (index[node] != NONE) {
+                size_t parent = nodes_[node].parent;
+                nodes_[index[node]] = {parent == NONE ? NONE : index[parent], nodes_[node].item};
+            }
+        nodes_.resize(kept);
+
+        if (best_node_ != NONE)
+            best_node_ = index[best_node_];
+        for (State& state : states_)
+            if (state.node != NONE)
+                state.node = index[state.node];
+        compact_at_ = std::max<size_t>(1 << 20, 2 * kept);
+    }
+};
+
+// Maiores capacidades aceitas pela programação dinâmica: a linha de valores
+// tem 8 bytes por capacidade e o conjunto de somas, 1 bit
+constexpr int64_t DP_MAX_CAPACITY = int64_t(1) << 26;
+constexpr int64_t SUBSET_SUM_MAX_CAPACITY = int64_t(1) << 34;
+
+// Uma linha da programação dinâmica, no semianel (max, +):
+// next[x] = max(row[x], row[x - w] + p). As versões AVX2 e AVX-512 fazem 4/8
+// capacidades por instrução e a escolhida em tempo de execução conforme a CPU
+inline void maxplus_row_scalar(const int64_t* row, int64_t* next, size_t size, size_t w, int64_t p, size_t from) {
+    for (size_t x = from; x < size; ++x)
+        next[x] = std::max(row[x], row[x - w] + p);
+}
+
+#ifdef KNAPSACK_X86
+__attribute__((target("avx2")))
+inline void maxplus_row_avx2(const int64_t* row, int64_t* next, size_t size, size_t w, int64_t p) {
+    __m256i profit = _mm256_set1_epi64x(p);
+    size_t x = w;
+    for (; x + 4 <= size; x += 4) {
+        __m256i keep = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + x));
+        __m256i take = _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + x - w)), profit);
+        __m256i best = _mm256_blendv_epi8(keep, take, _mm256_cmpgt_epi64(take, keep));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(next + x), best);
+    }
+    maxplus_row_scalar(row, next, size, w, p, x);
+}
+
+__attribute__((target("avx512f")))
+inline void maxplus_row_avx512(const int64_t* row, int64_t* next, size_t size, size_t w, int64_t p) {
+    __m512i profit = _mm512_set1_epi64(p);
+    size_t x = w;
+    for (; x + 8 <= size; x += 8) {
+        __m512i keep = _mm512_loadu_si512(row + x);
+        __m512i take = _mm512_add_epi64(_mm512_loadu_si512(row + x - w), profit);
+        _mm512_storeu_si512(next + x, _mm512_mask_blend_epi64(_mm512_cmpgt_epi64_mask(take, keep), keep, take));
+    }
+    maxplus_row_scalar(row, next, size, w, p, x);
+}
+#endif
+
+inline void maxplus_row(const int64_t* row, int64_t* next, size_t size, size_t w, int64_t p) {
+    std::copy(row, row + std::min(w, size), next);
+#ifdef KNAPSACK_X86
+    static const int level = __builtin_cpu_supports("avx512f") ? 2 : __builtin_cpu_supports("avx2") ? 1 : 0;
+    if (level == 2)
+        return maxplus_row_avx512(row, next, size, w, p);
+    if (level == 1)
+        return maxplus_row_avx2(row, next, size, w, p);
+#endif
+    maxplus_row_scalar(row, next, size, w, p, w);
+}
+
+// dst[i] = src[i] | (src deslocado de q palavras e r bits)[i], para i em
+// [from, to), com from > q e 0 < r < 64; a versão AVX2 faz 4 palavras por vez
+inline void shift_or_scalar(const uint64_t* src, uint64_t* dst, size_t from, size_t to, size_t q, unsigned r) {
+    for (size_t i = from; i < to; ++i)
+        dst[i] = src[i] | src[i - q] << r | src[i - q - 1] >> (64 - r);
+}
+
+#ifdef KNAPSACK_X86
+__attribute__((target("avx2")))
+inline void shift_or_avx2(const uint64_t* src, uint64_t* dst, size_t from, size_t to, size_t q, unsigned r) {
+    __m128i left = _mm_cvtsi32_si128(r), right = _mm_cvtsi32_si128(64 - r);
+    size_t i = from;
+    for (; i + 4 <= to; i += 4) {
+        __m256i word = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i - q));
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i - q - 1));
+        word = _mm256_or_si256(word, _mm256_or_si256(_mm256_sll_epi64(high, left), _mm256_srl_epi64(low, right)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), word);
+    }
+    shift_or_scalar(src, dst, i, to, q, r);
+}
+#endif
+
+inline void shift_or(const uint64_t* src, uint64_t* dst, size_t from, size_t to, size_t q, unsigned r) {
+#ifdef KNAPSACK_X86
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx2)
+        return shift_or_avx2(src, dst, from, to, q, r);
+#endif
+    shift_or_scalar(src, dst, from, to, q, r);
+}
+
+// Conjunto das somas alcançáveis até uma capacidade, um bit por soma.
+// Incluir um item de peso w é deslocar o conjunto w bits e juntar com "ou",
+// 64 somas por vez. O resultado vai para um segundo vetor, sem dependência
+// entre as palavras, e só até a maior soma já alcançável
+class SubsetSums {
+public:
+    explicit SubsetSums(int64_t capacity)
+        : capacity_(capacity), words_(capacity / 64 + 1, 0), next_(words_.size()) { words_[0] = 1; }
+
+    void add(int64_t w) {
+        size_t q = w / 64, r = w % 64;
+        reach_ = std::min(reach_ + w, capacity_);
+        size_t used = reach_ / 64 + 1;
+        if (q >= used)
+            return;
+
+        const uint64_t* src = words_.data();
+        uint64_t* dst = next_.data();
+        std::copy(src, src + q, dst);
+        dst[q] = src[q] | src[0] << r;
+        if (r == 0) {
+            for (size_t i = q + 1; i < used; ++i)
+                dst[i] = src[i] | src[i - q];
+        } else {
+            shift_or(src, dst, q + 1, used, q, r);
+        }
+        // Bits da última palavra acima da capacidade não são somas válidas
+        if (used == words_.size())
+            if (int top = capacity_ % 64 + 1; top < 64)
+                dst[used - 1] &= (uint64_t(1) << top) - 1;
+        words_.swap(next_);
+    }
+
+    bool contains(int64_t sum) const { return sum >= 0 && sum <= capacity_ && (words_[sum / 64] >> (sum % 64) & 1); }
+
+    // Maior soma alcançável
+    int64_t max() const {
+        for (size_t i = words_.size(); i-- > 0;)
+            if (words_[i])
+                return 64 * i + 63 - __builtin_clzll(words_[i]);
+        return 0;
+    }
+
+private:
+    int64_t capacity_;
+    int64_t reach_ = 0;  // maior soma possível com os itens já incluídos
+    std::vector<uint64_t> words_, next_;
+};
+
+// Programação dinâmica da mochila com memória O(W). As linhas guardam só
+// valores; os itens escolhidos são recuperados como no algoritmo de
+// Hirschberg: divide os itens ao meio, calcula a última linha de cada metade
+// e escolhe a divisão da capacidade entre elas que atinge o ótimo. Cada
+// nível da recursão custa O(nW) e só as linhas de um nó existem ao mesmo
+// tempo. No subset-sum (todo valor igual ao peso, ou subset_sum pedido) as
+// linhas são conjuntos de somas em bits em vez de valores
+class DpKnapsack {
+public:
+    DpKnapsack(const KnapsackInstance& instance, bool subset_sum) : capacity_(instance.capacity) {
+        bool sums = true;
+        for (size_t i = 0; i < instance.size(); ++i) {
+            int64_t w = instance.weights[i], p = subset_sum ? w : instance.values[i];
+            if (w == 0) {
+                free_.push_back(i);
+            } else if (w <= capacity_ && p > 0) {
+                items_.push_back(i);
+                w_.push_back(w);
+                p_.push_back(p);
+                sums = sums && p == w;
+            }
+        }
+        bits_ = sums;
+        if (capacity_ > (bits_ ? SUBSET_SUM_MAX_CAPACITY : DP_MAX_CAPACITY))
+            throw std::runtime_error("capacidade grande demais para a programação dinâmica");
+    }
+
+    KnapsackResult solve(const KnapsackInstance& instance) const {
+        int64_t total = 0;
+        for (int64_t w : w_)
+            total += w;
+
+        // No subset-sum, a recuperação procura a maior soma alcançável exata
+        int64_t target = std::min(capacity_, total);
+        if (bits_ && !items_.empty())
+            target = sums(0, items_.size(), target).max();
+
+        KnapsackResult result;
+        result.chosen = free_;
+        recover(0, items_.size(), target, result.chosen);
+        std::sort(result.chosen.begin(), result.chosen.end());
+        for (size_t i : result.chosen) {
+            result.weight += instance.weights[i];
+            result.value += instance.values[i];
+        }
+        result.bound = result.value;
+        result.core = items_.size();
+        return result;
+    }
+
+private:
+    int64_t capacity_;
+    bool bits_;
+    std::vector<size_t> items_, free_;
+    std::vector<int64_t> w_, p_;
+
+    // Última linha da DP dos itens [lo, hi) até a capacidade c
+    std::vector<int64_t> values(size_t lo, size_t hi, int64_t c) const {
+        std::vector<int64_t> row(c + 1, 0), next(c + 1);
+        for (size_t k = lo; k < hi; ++k) {
+            if (w_[k] > c)
+                continue;
+            maxplus_row(row.data(), next.data(), c + 1, w_[k], p_[k]);
+            row.swap(next);
+        }
+        return row;
+    }
+
+    SubsetSums sums(size_t lo, size_t hi, int64_t c) const {
+        SubsetSums reached(c);
+        for (size_t k = lo; k < hi; ++k)
+            reached.add(w_[k]);
+        return reached;
+    }
+
+    // Escolhe itens de [lo, hi) que atingem o ótimo com capacidade c; no
+    // subset-sum, c é a soma exata a atingir
+    void recover(size_t lo, size_t hi, int64_t c, std::vector<size_t>& chosen) const {
+        if (c <= 0 || lo == hi)
+            return;
+        int64_t total = 0;
+        for (size_t k = lo; k < hi; ++k)
+            total += w_[k];
+        if (total <= c || hi - lo == 1) {
+            for (size_t k = lo; k < hi; ++k)
+                if (w_[k] <= c)
+                    chosen.push_back(items_[k]);
+            return;
+        }
+
+        size_t mid = lo + (hi - lo) / 2;
+        int64_t split = 0;
+        if (bits_) {
+            SubsetSums left = sums(lo, mid, c), right = sums(mid, hi, c);
+            while (!(left.contains(split) && right.contains(c - split)))
+                ++split;
+        } else {
+            std::vector<int64_t> left = values(lo, mid, c), right = values(mid, hi, c);
+            for (int64_t x = 1; x <= c; ++x)
+                if (left[x] + right[c - x] > left[split] + right[c - split])
+                    split = x;
+        }
+        recover(lo, mid, split, chosen);
+        recover(mid, hi, c - split, chosen);
+    }
+};
+
+#endif
@@ -0,0 +1,102 @@
+/*
+  Teste de alocações da busca local: substitui o operator new global por um
+  contador e executa o worker bin_packing_ff real, com a árvore e com a
+  varredura, uma vez com prazo curto e outra com prazo dez vezes maior. A
+  preparação (classes de tamanho, sorteador, avaliador) e a cópia final da
+  ordem alocam o mesmo nas duas execuções, então o número de alocações só
+  pode coincidir se o laço da busca, incluindo as publicações de novas
+  incumbentes, não tocar o heap.
+
+  Uso: test-allocations
+  Retorna 0 se as contagens coincidem.
+*/
+
+// O GCC vê o malloc dentro do operator new substituído e acusa o free dos
+// operator delete como par trocado; aqui o par é justamente esse
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <cstdlib>
+#include <cstdint>
+
+#include "bin-packing.hpp"
+
+static std::atomic<uint64_t> allocations{0};
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    ++allocations;
+    std::size_t alignment = static_cast<std::size_t>(align);
+    if (void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+struct Run {
+    uint64_t allocations, evaluations;
+    size_t improvements;
+};
+
+// Executa o worker sobre uma permutação aleatória empacotada pelo First Fit,
+// para que a busca encontre e publique muitas melhoras
+template <typename Size, typename Index>
+Run run_worker(const std::vector<Size>& items, Size capacity, double seconds) {
+    SearchOptions options;
+    options.heuristic = "ff";
+    SearchState<Size> state;
+    SearchResult<Size> result{};
+    std::vector<Size> initial = prepare_search(items, capacity, options, {}, state, result, 1);
+    state.deadline = state.start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                       std::chrono::duration<double>(seconds));
+
+    uint64_t before = allocations;
+    bin_packing_ff<Size, Index>(state, std::move(initial), capacity, 1);
+    Run run{allocations - before, state.evaluations, 0};
+
+    std::lock_guard<std::mutex> lock(state.trace_mutex);
+    run.improvements = state.trace.size();
+    return run;
+}
+
+template <typename Size, typename Index>
+int check(const char* name) {
+    Rng rng(7);
+    std::vector<Size> items(1000);
+    for (Size& item : items)
+        item = Size(20 + gen_random_index(rng, 81));  // Falkenauer u: [20, 100] com capacidade 150
+    Size capacity = 150;
+
+    Run short_run = run_worker<Size, Index>(items, capacity, 0.05);
+    Run long_run = run_worker<Size, Index>(items, capacity, 0.5);
+    bool ok = short_run.allocations == long_run.allocations && long_run.evaluations > short_run.evaluations;
+
+    std::cout << name << ": " << short_run.allocations << " alocações em " << short_run.evaluations
+              << " avaliações (" << short_run.improvements << " melhoras), " << long_run.allocations
+              << " em " << long_run.evaluations << " (" << long_run.improvements << " melhoras), "
+              << (ok ? "ok" : "FALHOU") << "\n";
+    return ok ? 0 : 1;
+}
+
+int main() {
+    int failures = 0;
+    failures += check<int64_t, FirstFitTree<int64_t>>("árvore, int64");
+    failures += check<int64_t, FirstFitScan<int64_t>>("varredura, int64");
+    failures += check<int32_t, FirstFitTree<int32_t>>("árvore, int32");
+    failures += check<int32_t, FirstFitScan<int32_t>>("varredura, int32");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,160 @@
+/*
+  Teste de equivalência do First Fit: compara o empacotamento da versão
+  original de fitness_first_fit (que somava o conteúdo de cada bin para cada
+  item) com pack_first_fit, fitness_first_fit e o SwapEvaluator com árvore e
+  com varredura, em permutações aleatórias de bin-packing.dat (inteiros) e
+  bin-packing-new.dat (frações em ponto fixo, como em bin-packing-new.cpp).
+
+  Uso: test-first-fit [bin-packing.dat] [bin-packing-new.dat]
+  Retorna 0 se todos os empacotamentos coincidem.
+*/
+
+#include <iostream>
+#include <vector>
+#include <numeric>
+#include <random>
+#include <string>
+#include <cmath>
+#include <cstdint>
+
+#include "bin-packing.hpp"
+#include "bin-packing-io.hpp"
+
+const int32_t FIXED_SCALE = 1000000;
+const int PERMUTATIONS = 200;
+
+// Versões originais de bin-packing.cpp e bin-packing-new.cpp
+std::vector<std::vector<int>> reference_first_fit(const std::vector<int>& items, int capacity) {
+    std::vector<std::vector<int>> bins;
+
+    for (int item : items) {
+        bool placed = false;
+        for (auto& bin : bins) {
+            int sum = std::accumulate(bin.begin(), bin.end(), 0);
+            if (sum + item <= capacity) {
+                bin.push_back(item);
+                placed = true;
+                break;
+            }
+        }
+
+        if (!placed)
+            bins.push_back({item});
+    }
+
+    return bins;
+}
+
+std::vector<std::vector<float>> reference_first_fit(const std::vector<float>& items, float capacity) {
+    std::vector<std::vector<float>> bins;
+    const float epsilon = 1e-5f;  // For floating-point comparisons
+
+    for (float item : items) {
+        bool placed = false;
+        for (auto& bin : bins) {
+            float sum = std::accumulate(bin.begin(), bin.end(), 0.0f);
+            if (sum + item <= capacity + epsilon) {
+                bin.push_back(item);
+                placed = true;
+                break;
+            }
+        }
+
+        if (!placed) {
+            bins.push_back({item});
+        }
+    }
+
+    return bins;
+}
+
+// Conversões entre o tipo da versão original (int ou float) e o do núcleo
+// (inteiros ou ponto fixo com escala scale)
+template <typename Original, typename Size>
+Original to_original(Size value, int32_t scale) {
+    return scale == 1 ? Original(value) : Original(double(value) / scale);
+}
+
+template <typename Original, typename Size>
+std::vector<Original> to_original(const std::vector<Size>& items, int32_t scale) {
+    std::vector<Original> converted;
+    for (Size item : items)
+        converted.push_back(to_original<Original>(item, scale));
+    return converted;
+}
+
+template <typename Size, typename Original>
+std::vector<std::vector<Size>> to_core(const std::vector<std::vector<Original>>& bins, int32_t scale) {
+    std::vector<std::vector<Size>> converted;
+    for (const auto& bin : bins) {
+        converted.emplace_back();
+        for (Original item : bin)
+            converted.back().push_back(scale == 1 ? Size(item) : Size(std::llround(double(item) * scale)));
+    }
+    return converted;
+}
+
+template <typename Size>
+std::vector<std::vector<Size>> from_packing(const Packing<Size>& packing) {
+    std::vector<std::vector<Size>> bins;
+    for (size_t b = 0; b < packing.bins(); ++b)
+        bins.emplace_back(packing.begin(b), packing.end(b));
+    return bins;
+}
+
+// Compara o núcleo com a versão original do tipo Original em PERMUTATIONS
+// permutações de items
+template <typename Original, typename Size>
+int check(const std::string& name, std::vector<Size> items, Size capacity, int32_t scale) {
+    auto original = [&](const auto& value) { return to_original<Original>(value, scale); };
+    std::mt19937 gen(1);
+    int failures = 0;
+    for (int r = 0; r < PERMUTATIONS; ++r) {
+        std::shuffle(items.begin(), items.end(), gen);
+        auto expected = to_core<Size>(reference_first_fit(original(items), original(capacity)), scale);
+
+        if (from_packing(pack_first_fit(items, capacity)) != expected) {
+            std::cout << name << ": pack_first_fit diverge na permutação " << r << "\n";
+            ++failures;
+        }
+        if (fitness_first_fit(items, capacity) != expected.size()) {
+            std::cout << name << ": fitness_first_fit diverge na permutação " << r << "\n";
+            ++failures;
+        }
+
+        // Uma troca avaliada pelo SwapEvaluator tem de dar o mesmo número de
+        // bins que o First Fit original sobre a permutação trocada
+        size_t a = gen() % items.size(), b = gen() % items.size();
+        std::vector<Size> swapped = items;
+        std::swap(swapped[a], swapped[b]);
+        size_t bins = reference_first_fit(original(swapped), original(capacity)).size();
+        SwapEvaluator<Size, FirstFitTree<Size>> tree(items, capacity);
+        SwapEvaluator<Size, FirstFitScan<Size>> scan(items, capacity);
+        if (size_t(tree.try_swap(a, b)) != bins || size_t(scan.try_swap(a, b)) != bins) {
+            std::cout << name << ": SwapEvaluator diverge na permutação " << r << "\n";
+            ++failures;
+        }
+    }
+    std::cout << name << ": " << items.size() << " itens, " << PERMUTATIONS << " permutações, "
+              << (failures ? "FALHOU" : "ok") << "\n";
+    return failures;
+}
+
+int main(int argc, char* argv[]) {
+    std::string integer_path = argc > 1 ? argv[1] : "bin-packing.dat";
+    std::string fixed_path = argc > 2 ? argv[2] : "bin-packing-new.dat";
+
+    int failures = 0;
+    try {
+        Instance<int64_t> integer = load_integer_instance(integer_path);
+        failures += check<int>(integer_path, integer.items, integer.capacity, 1);
+
+        Instance<int32_t> fixed = load_fixed_instance(fixed_path, FIXED_SCALE);
+        failures += check<float>(fixed_path, fixed.items, fixed.capacity, FIXED_SCALE);
+    } catch (const std::exception& e) {
+        std::cerr << "Erro na leitura da instância: " << e.what() << "\n";
+        return 1;
+    }
+
+    return failures ? 1 : 0;
+}
@@ -19,48 +19,54 @@
   - Depósito 1: 150 unidades
   - Depósito 2: 70 unidades
   - Depósito 3: 60 unidades
+
+  Uso: transporte [--instancia arquivo.dat] [--motor simplex|cplex|comparar]
+                  [--partida vogel|artificial]
+
+  A instância é lida do arquivo ou da entrada padrão (formato em
+  transporte.hpp; transporte.dat é o exemplo acima). O motor padrão é o
+  simplex de redes, partindo da solução de Vogel ou da base artificial;
+  cplex resolve o modelo inteiro sobre a lista de rotas e comparar executa
+  os dois e confere os custos.
 */
 
 #include <ilcplex/ilocplex.h>
 #include <vector>
+#include <string>
+#include <cmath>
 
-ILOSTLBEGIN;
-
-const std::vector<std::vector<int>> CUSTOS = {
-  { 8, 5, 6 },  // Custos de transporte da Fábrica 1 para os depósitos 1, 2, 3
-  { 15, 10, 12 },  // Custos de transporte da Fábrica 2 para os depósitos 1, 2, 3
-  { 3, 9, 10 },  // Custos de transporte da Fábrica 3 para os depósitos 1, 2, 3
-};
-
-const std::vector<int> CAPACIDADES = {
-  120, 80, 80  // Capacidades das fábricas 1, 2, 3
-};
+#include "transporte.hpp"
+#include "arc-index.hpp"
 
-const std::vector<int> DEMANDAS = {
-  150, 70, 60  // Demandas dos depósitos 1, 2, 3
-};
+ILOSTLBEGIN;
 
-int main() {
+// Modelo inteiro sobre a lista de rotas, mantido como referência para
+// conferir o simplex de redes: o modelo só tem variáveis e termos para os
+// pares que existem, e as linhas de cada fábrica e de cada depósito são
+// montadas a partir dos índices das rotas que saem (CSR) e que chegam (CSC).
+// Retorna false se o CPLEX não resolveu o problema
+bool solve_cplex(const TransportInstance& instance, TransportResult& result) {
   IloEnv env;
   IloModel model(env);
 
-  // Definindo variáveis de decisão x[i][j], onde:
-  // x[i][j] é a quantidade transportada da fábrica i para o depósito j
-  IloArray<IloIntVarArray> x(env, 3);  // 3 fábricas e 3 depósitos
+  int fabricas = instance.supplies.size();
+  int depositos = instance.demands.size();
+  const std::vector<TransportRoute>& rotas = instance.routes;
+  size_t m = rotas.size();
+  ArcIndex saidas(fabricas, m, [&](size_t k) { return rotas[k].factory; });
+  ArcIndex chegadas(depositos, m, [&](size_t k) { return rotas[k].depot; });
 
-  // Inicializando as variáveis de decisão, com limites de 0 até infinito
-  for (unsigned i = 0; i < 3; i++) {
-    x[i] = IloIntVarArray(env, 3, 0, IloInfinity);  // Cada fábrica tem 3 depósitos
-  }
+  // Definindo variáveis de decisão x[k], a quantidade transportada pela
+  // rota k, da fábrica rotas[k].factory para o depósito rotas[k].depot,
+  // com limites de 0 até infinito
+  IloIntVarArray x(env, m, 0, IloInfinity);
 
   // Função Objetivo: Minimizar o custo de transporte
   IloExpr obj_expr(env);
-  
-  // Percorre todos os pares de fábricas e depósitos para calcular o custo total
-  for (unsigned i = 0; i < 3; i++) {
-    for (unsigned j = 0; j < 3; j++) {
-      obj_expr += CUSTOS[i][j] * x[i][j];  // Custo de transporte entre fábrica i e depósito j
-    }
+
+  // Percorre todas as rotas para calcular o custo total
+  for (size_t k = 0; k < m; k++) {
+    obj_expr += double(rotas[k].cost) * x[k];  // Custo de transporte da rota k
   }
 
   // Definindo a função objetivo como minimização do custo
@@ -69,26 +75,108 @@ int main() {
 
   // Restrições de capacidade das fábricas
   // A quantidade de unidades enviadas de cada fábrica não pode exceder sua capacidade
-  for (unsigned i = 0; i < 3; i++) {
-    model.add((x[i][0] + x[i][1] + x[i][2]) <= CAPACIDADES[i]);  // Soma das variáveis para a fábrica i
+  IloRangeArray capacidade(env);
+  for (int i = 0; i < fabricas; i++) {
+    IloExpr enviado(env);
+    for (const size_t* k = saidas.begin(i); k != saidas.end(i); ++k)
+      enviado += x[*k];  // Soma das variáveis para a fábrica i
+    capacidade.add(IloRange(env, -IloInfinity, enviado, double(instance.supplies[i])));
+    enviado.end();
   }
+  model.add(capacidade);
 
   // Restrições de demanda dos depósitos
   // A quantidade total recebida por cada depósito deve ser igual à sua demanda
-  for (unsigned i = 0; i < 3; i++) {
-    model.add((x[0][i] + x[1][i] + x[2][i]) == DEMANDAS[i]);  // Soma das variáveis para o depósito i
+  IloRangeArray demanda(env);
+  for (int j = 0; j < depositos; j++) {
+    IloExpr recebido(env);
+    for (const size_t* k = chegadas.begin(j); k != chegadas.end(j); ++k)
+      recebido += x[*k];  // Soma das variáveis para o depósito j
+    demanda.add(IloRange(env, double(instance.demands[j]), recebido, double(instance.demands[j])));
+    recebido.end();
   }
+  model.add(demanda);
 
   // Resolver o modelo usando CPLEX
   IloCplex cplex(model);
-  IloBool result = cplex.solve();  // Tenta resolver o problema de otimização
+  cplex.setOut(env.getNullStream());
+  bool solved = cplex.solve();  // Tenta resolver o problema de otimização
+
+  if (solved) {
+    result.feasible = true;
+    result.cost = std::llround(cplex.getObjValue());
+    result.shipments.assign(m, 0);
+    for (size_t k = 0; k < m; k++)
+      result.shipments[k] = std::llround(cplex.getValue(x[k]));
+  }
+
+  env.end();
+  return solved;
+}
+
+int main(int argc, char* argv[]) {
+  std::string path = "-";
+  std::string engine = "simplex";
+  std::string start = "vogel";
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (std::string(argv[i]) == "--instancia")
+      path = argv[++i];
+    else if (std::string(argv[i]) == "--motor")
+      engine = argv[++i];
+    else if (std::string(argv[i]) == "--partida")
+      start = argv[++i];
+  }
+  if (engine != "simplex" && engine != "cplex" && engine != "comparar") {
+    fprintf(stderr, "Motor desconhecido: %s\n", engine.c_str());
+    return 1;
+  }
+  if (start != "vogel" && start != "artificial") {
+    fprintf(stderr, "Partida desconhecida: %s\n", start.c_str());
+    return 1;
+  }
+
+  TransportInstance instance;
+  try {
+    instance = load_transport(path);
+  } catch (const std::exception& e) {
+    fprintf(stderr, "Erro na leitura da instância: %s\n", e.what());
+    return 1;
+  }
+
+  TransportResult result;
+  if (engine != "cplex") {
+    result = NetworkSimplex(instance, start == "vogel").solve();
+    printf("Simplex de redes: partida de custo %lld, %llu pivôs em %.3f s\n",
+           (long long)result.start_cost, (unsigned long long)result.pivots, result.seconds);
+  }
+  if (engine == "cplex" || engine == "comparar") {
+    TransportResult reference;
+    bool solved = solve_cplex(instance, reference);
+    if (engine == "comparar" && solved) {
+      printf("Custo mínimo do CPLEX: %lld\n", (long long)reference.cost);
+      if (!result.feasible || reference.cost != result.cost) {
+        printf("Divergência entre o simplex de redes e o CPLEX!\n");
+        return 1;
+      }
+      printf("Custos conferem\n");
+    } else if (engine == "cplex") {
+      result = reference;
+    }
+  }
 
   // Verifica se a solução foi encontrada
-  if (result) {
-    printf("Problema resolvido!\n");
-    printf("Custo mínimo: %f\n", cplex.getObjValue());  // Imprime o custo mínimo encontrado
-  } else {
+  if (!result.feasible) {
     printf("Problema não resolvido\n");
+    return 1;
+  }
+  printf("Problema resolvido!\n");
+  printf("Custo mínimo: %f\n", double(result.cost));  // Imprime o custo mínimo encontrado
+
+  // Quantidades transportadas em cada rota usada
+  for (size_t k = 0; k < instance.routes.size(); k++) {
+    if (result.shipments[k] > 0)
+      printf("Fábrica %d → Depósito %d: %lld unidades\n", instance.routes[k].factory + 1,
+             instance.routes[k].depot + 1, (long long)result.shipments[k]);
   }
 
   return 0;
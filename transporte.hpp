@@ -0,0 +1,593 @@
+/*
+  Problema de transporte como fluxo de custo mínimo, resolvido pelo simplex
+  de redes com partida artificial ou de Vogel. Só os pares com rota viram
+  arcos, então instâncias esparsas não pagam por fábricas x depósitos.
+
+  Formato da instância: "fábricas depósitos rotas", seguido das ofertas das
+  fábricas, das demandas dos depósitos e de uma linha "fábrica depósito
+  custo" por rota, fábricas e depósitos numerados a partir de 1. Pares sem
+  rota não podem ser usados.
+*/
+
+#ifndef TRANSPORTE_HPP
+#define TRANSPORTE_HPP
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <queue>
+#include <tuple>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <limits>
+#include <chrono>
+#include <cstdint>
+
+#include "input-file.hpp"
+
+struct TransportRoute {
+    int factory, depot;  // a partir de 0
+    int64_t cost;
+};
+
+struct TransportInstance {
+    std::vector<int64_t> supplies;  // oferta máxima de cada fábrica
+    std::vector<int64_t> demands;   // demanda exata de cada depósito
+    std::vector<TransportRoute> routes;
+};
+
+struct TransportResult {
+    bool feasible = false;
+    int64_t cost = 0;
+    std::vector<int64_t> shipments;  // quantidade em cada rota
+    int64_t start_cost = 0;          // custo da solução de partida
+    uint64_t pivots = 0;
+    double seconds = 0;
+};
+
+// Lê a instância de path ("-" é a entrada padrão)
+inline TransportInstance load_transport(const std::string& path) {
+    InputFile input(path);
+    std::istream& in = input.stream();
+
+    TransportInstance instance;
+    long long factories, depots, routes;
+    if (!(in >> factories >> depots >> routes) || factories < 1 || depots < 1 || routes < 0)
+        throw std::runtime_error("cabeçalho inválido: esperado \"fábricas depósitos rotas\"");
+    instance.supplies.resize(factories);
+    instance.demands.resize(depots);
+    for (auto& supply : instance.supplies)
+        if (!(in >> supply) || supply < 0)
+            throw std::runtime_error("oferta inválida");
+    for (auto& demand : instance.demands)
+        if (!(in >> demand) || demand < 0)
+            throw std::runtime_error("demanda inválida");
+    instance.routes.resize(routes);
+    for (auto& route : instance.routes) {
+        long long i, j, cost;
+        if (!(in >> i >> j >> cost) || i < 1 || i > factories || j < 1 || j > depots)
+            throw std::runtime_error("rota inválida");
+        route = {int(i - 1), int(j - 1), cost};
+    }
+    return instance;
+}
+
+// Simplex de redes primal (na linha do NetworkSimplex da LEMON) sobre a rede
+// fábricas -> depósitos, com um depósito fictício de custo zero que absorve
+// a oferta excedente e uma raiz artificial ligada a todos os nós por arcos de
+// custo alto. A árvore geradora fica em vetores por nó (pai, arco do pai e
+// sentido, sucessor na ordem de profundidade, número de descendentes e
+// último descendente), e cada pivô só percorre o ciclo e a subárvore que
+// muda de lugar. O arco que entra vem da busca em blocos: percorre os arcos
+// em blocos de ~sqrt(m) a partir de onde parou e escolhe o de custo reduzido
+// mais negativo do primeiro bloco que tiver algum. A partida pode ser a base
+// artificial ou a de Vogel, que costuma deixar pouco trabalho ao simplex
+class NetworkSimplex {
+public:
+    NetworkSimplex(const TransportInstance& instance, bool vogel)
+        : factories_(instance.supplies.size()), depots_(instance.demands.size()), routes_(instance.routes.size()),
+          vogel_(vogel) {
+        int64_t supply = 0, demand = 0;
+        for (int64_t s : instance.supplies)
+            supply += s;
+        for (int64_t d : instance.demands)
+            demand += d;
+        excess_ = supply - demand;
+
+        // Nós: fábricas, depósitos, o fictício (se sobra oferta) e a raiz
+        nodes_ = factories_ + depots_ + (excess_ > 0) + 1;
+        root_ = nodes_ - 1;
+        supply_.assign(nodes_, 0);
+        for (int i = 0; i < factories_; ++i)
+            supply_[i] = instance.supplies[i];
+        for (int j = 0; j < depots_; ++j)
+            supply_[factories_ + j] = -instance.demands[j];
+        if (excess_ > 0)
+            supply_[factories_ + depots_] = -excess_;
+
+        // Arcos: rotas, fábrica -> fictício e um artificial por nó
+        for (const TransportRoute& route : instance.routes)
+            add_arc(route.factory, factories_ + route.depot, route.cost);
+        if (excess_ > 0)
+            for (int i = 0; i < factories_; ++i)
+                add_arc(i, factories_ + depots_, 0);
+        real_arcs_ = source_.size();
+
+        int64_t max_cost = 0;
+        for (const TransportRoute& route : instance.routes)
+            max_cost = std::max(max_cost, std::abs(route.cost));
+        artificial_cost_ = (max_cost + 1) * nodes_;
+        for (int u = 0; u < root_; ++u)
+            add_arc(root_, u, artificial_cost_);
+    }
+
+    TransportResult solve() {
+        auto start = std::chrono::steady_clock::now();
+        TransportResult result;
+        if (excess_ < 0)
+            return result;  // oferta total menor que a demanda
+
+        if (!(vogel_ && build_tree(vogel())))
+            build_tree(std::vector<int64_t>(real_arcs_, 0));
+        result.start_cost = cost();
+
+        size_t arcs = source_.size();
+        block_ = std::max<size_t>(10, std::sqrt(double(arcs)));
+        while (find_entering()) {
+            if (!find_leaving())
+                throw std::runtime_error("problema ilimitado");
+            change_flow();
+            update_tree();
+            update_potential();
+            ++result.pivots;
+        }
+
+        result.feasible = true;
+        for (size_t a = real_arcs_; a < arcs; ++a)
+            result.feasible = result.feasible && flow_[a] == 0;
+        result.cost = cost();
+        result.shipments.assign(flow_.begin(), flow_.begin() + routes_);
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+private:
+    static constexpr int TREE = 0, LOWER = 1;    // estado dos arcos
+    static constexpr int UP = 1, DOWN = -1;      // arco do pai: u -> pai ou pai -> u
+    static constexpr int64_t INF = std::numeric_limits<int64_t>::max();
+
+    int factories_, depots_, nodes_, root_;
+    size_t routes_, real_arcs_ = 0, block_ = 0, next_arc_ = 0;
+    bool vogel_;
+    int64_t excess_, artificial_cost_ = 0;
+    std::vector<int64_t> supply_;
+
+    std::vector<int> source_, target_;
+    std::vector<int64_t> cost_, flow_;
+    std::vector<signed char> state_;
+
+    std::vector<int> parent_, pred_, thread_, rev_thread_, succ_num_, last_succ_;
+    std::vector<signed char> pred_dir_;
+    std::vector<int64_t> pi_;
+    std::vector<int> dirty_revs_;
+
+    // Pivô corrente: arco que entra, nós do ciclo e arco que sai (o do pai de u_out)
+    int in_arc_ = -1, join_ = -1, u_in_ = -1, v_in_ = -1, u_out_ = -1;
+    int64_t delta_ = 0;
+
+    void add_arc(int u, int v, int64_t c) {
+        source_.push_back(u);
+        target_.push_back(v);
+        cost_.push_back(c);
+    }
+
+    int64_t cost() const {
+        int64_t total = 0;
+        for (size_t a = 0; a < routes_; ++a)
+            total += cost_[a] * flow_[a];
+        return total;
+    }
+
+    // Método de Vogel: em cada passo, a linha (fábrica ou depósito) com a
+    // maior diferença entre os dois menores custos ainda disponíveis recebe
+    // o máximo possível na sua rota mais barata, e a linha esgotada sai. As
+    // rotas de cada linha ficam ordenadas por custo, com ponteiros que só
+    // avançam para o primeiro e o segundo candidatos vivos, e as diferenças
+    // ficam num heap, recalculadas só para as linhas cujo primeiro ou
+    // segundo candidato saiu. O depósito fictício fica de fora, senão seus
+    // custos zero dominariam as diferenças, e recebe no fim a oferta que
+    // sobrou. Retorna o fluxo de cada arco real
+    std::vector<int64_t> vogel() const {
+        // As linhas são os próprios nós: fábricas e depósitos
+        int lines = factories_ + depots_;
+        auto other = [&](int line, size_t a) { return line < factories_ ? target_[a] : source_[a]; };
+
+        std::vector<size_t> first(lines + 1, 0);
+        for (size_t a = 0; a < routes_; ++a) {
+            ++first[source_[a] + 1];
+            ++first[target_[a] + 1];
+        }
+        for (int l = 0; l < lines; ++l)
+            first[l + 1] += first[l];
+        std::vector<size_t> list(first[lines]), next(first.begin(), first.end() - 1);
+        for (size_t a = 0; a < routes_; ++a) {
+            list[next[source_[a]]++] = a;
+            list[next[target_[a]]++] = a;
+        }
+        std::vector<std::pair<int64_t, size_t>> keyed;
+        for (int l = 0; l < lines; ++l) {
+            keyed.clear();
+            for (size_t k = first[l]; k < first[l + 1]; ++k)
+                keyed.push_back({cost_[list[k]], list[k]});
+            std::sort(keyed.begin(), keyed.end());
+            for (size_t k = first[l]; k < first[l + 1]; ++k)
+                list[k] = keyed[k - first[l]].second;
+        }
+
+        std::vector<int64_t> residual(lines);
+        for (int l = 0; l < lines; ++l)
+            residual[l] = std::abs(supply_[l]);
+        std::vector<char> alive(lines);
+        for (int l = 0; l < lines; ++l)
+            alive[l] = residual[l] > 0;
+        std::vector<size_t> best(first.begin(), first.end() - 1), second(best);
+        std::vector<int> version(lines, 0);
+
+        // Diferença entre os dois menores custos vivos da linha, ou o próprio
+        // custo se só resta uma rota; -1 se não resta nenhuma
+        auto penalty = [&](int l) -> int64_t {
+            size_t end = first[l + 1];
+            while (best[l] < end && !alive[other(l, list[best[l]])])
+                ++best[l];
+            if (best[l] == end)
+                return -1;
+            second[l] = std::max(second[l], best[l] + 1);
+            while (second[l] < end && !alive[other(l, list[second[l]])])
+                ++second[l];
+            int64_t c = cost_[list[best[l]]];
+            return second[l] == end ? c : cost_[list[second[l]]] - c;
+        };
+
+        std::priority_queue<std::tuple<int64_t, int, int>> heap;
+        for (int l = 0; l < lines; ++l)
+            if (alive[l])
+                heap.push({penalty(l), l, 0});
+
+        std::vector<int64_t> flows(real_arcs_, 0);
+        auto remove = [&](int l) {
+            alive[l] = 0;
+            for (size_t k = first[l]; k < first[l + 1]; ++k) {
+                size_t a = list[k];
+                int o = other(l, a);
+                size_t end = first[o + 1];
+                bool changed = (best[o] < end && list[best[o]] == a) || (second[o] < end && list[second[o]] == a);
+                if (alive[o] && changed)
+                    heap.push({penalty(o), o, ++version[o]});
+            }
+        };
+        while (!heap.empty()) {
+            auto [p, l, v] = heap.top();
+            heap.pop();
+            if (!alive[l] || v != version[l])
+                continue;
+            if (p < 0) {
+                alive[l] = 0;  // sem rotas vivas: o resíduo fica para a base artificial
+                continue;
+            }
+            size_t a = list[best[l]];
+            int o = other(l, a);
+            int64_t q = std::min(residual[l], residual[o]);
+            flows[a] = q;
+            residual[l] -= q;
+            residual[o] -= q;
+            // Quem esgotou sai; a outra linha cruza a que saiu e tem a
+            // diferença recalculada por remove
+            if (residual[o] == 0)
+                remove(o);
+            if (residual[l] == 0)
+                remove(l);
+        }
+        if (excess_ > 0)
+            for (int i = 0; i < factories_; ++i)
+                flows[routes_ + i] = residual[i];
+        return flows;
+    }
+
+    // Monta a base a partir do fluxo inicial dos arcos reais: os arcos com
+    // fluxo formam uma floresta (um arco que fecharia ciclo é ignorado), e
+    // cada componente se liga à raiz pelo arco artificial de um nó com
+    // resíduo, no sentido do resíduo total da componente (da raiz para o nó
+    // se for zero, para que os arcos de fluxo zero se afastem da raiz e a
+    // árvore seja fortemente viável). Os fluxos da árvore são recalculados
+    // pelas ofertas; retorna false se algum ficar negativo (e então a base
+    // artificial pura é usada)
+    bool build_tree(const std::vector<int64_t>& start) {
+        size_t arcs = source_.size();
+        flow_.assign(arcs, 0);
+        state_.assign(arcs, LOWER);
+        parent_.assign(nodes_, -1);
+        pred_.assign(nodes_, -1);
+        pred_dir_.assign(nodes_, UP);
+        thread_.assign(nodes_, -1);
+        rev_thread_.assign(nodes_, -1);
+        succ_num_.assign(nodes_, 1);
+        last_succ_.assign(nodes_, -1);
+        pi_.assign(nodes_, 0);
+
+        // Adjacência da floresta inicial e resíduo de cada nó
+        std::vector<std::vector<int>> tree(nodes_);
+        std::vector<int64_t> residual = supply_;
+        std::vector<int> set(nodes_);
+        for (int u = 0; u < nodes_; ++u)
+            set[u] = u;
+        auto find = [&](int u) {
+            while (set[u] != u)
+                u = set[u] = set[set[u]];
+            return u;
+        };
+        for (size_t a = 0; a < real_arcs_; ++a)
+            if (start[a] > 0 && find(source_[a]) != find(target_[a])) {
+                set[find(source_[a])] = find(target_[a]);
+                tree[source_[a]].push_back(a);
+                tree[target_[a]].push_back(a);
+                residual[source_[a]] -= start[a];
+                residual[target_[a]] += start[a];
+            }
+
+        // Componentes: cada uma pendura na raiz pelo nó com resíduo, se houver
+        std::vector<int> component(nodes_, -1), stack;
+        for (int u = 0; u < root_; ++u) {
+            if (component[u] >= 0)
+                continue;
+            int anchor = u;
+            int64_t total = 0;
+            stack.assign(1, u);
+            component[u] = u;
+            while (!stack.empty()) {
+                int v = stack.back();
+                stack.pop_back();
+                total += residual[v];
+                if (residual[v] != 0)
+                    anchor = v;
+                for (int a : tree[v]) {
+                    int w = source_[a] == v ? target_[a] : source_[a];
+                    if (component[w] < 0) {
+                        component[w] = u;
+                        stack.push_back(w);
+                    }
+                }
+            }
+            int a = real_arcs_ + anchor;
+            source_[a] = total > 0 ? anchor : root_;
+            target_[a] = total > 0 ? root_ : anchor;
+            tree[anchor].push_back(a);
+            tree[root_].push_back(a);
+        }
+
+        // Busca em profundidade a partir da raiz: pai, arco do pai e a
+        // ordem de profundidade (thread), circular a partir da raiz
+        std::vector<int> order;
+        order.reserve(nodes_);
+        std::vector<size_t> position(nodes_, 0);
+        stack.assign(1, root_);
+        while (!stack.empty()) {
+            int v = stack.back();
+            stack.pop_back();
+            order.push_back(v);
+            for (int a : tree[v]) {
+                int w = source_[a] == v ? target_[a] : source_[a];
+                if (a == pred_[v])
+                    continue;
+                parent_[w] = v;
+                pred_[w] = a;
+                pred_dir_[w] = source_[a] == w ? UP : DOWN;
+                state_[a] = TREE;
+                stack.push_back(w);
+            }
+        }
+        for (size_t k = 0; k < order.size(); ++k) {
+            thread_[order[k]] = order[(k + 1) % order.size()];
+            rev_thread_[order[(k + 1) % order.size()]] = order[k];
+            last_succ_[order[k]] = order[k];
+        }
+
+        // Descendentes, último descendente e fluxos, das folhas para a raiz
+        std::vector<int64_t> net = supply_;
+        bool feasible = true;
+        for (size_t k = order.size(); k-- > 1;) {
+            int v = order[k], p = parent_[v];
+            int64_t f = pred_dir_[v] == UP ? net[v] : -net[v];
+            feasible = feasible && f >= 0;
+            flow_[pred_[v]] = f;
+            net[p] += net[v];
+            succ_num_[p] += succ_num_[v];
+            if (last_succ_[p] == p)
+                last_succ_[p] = last_succ_[v];
+        }
+        if (!feasible)
+            return false;
+
+        // Potenciais: custo reduzido zero nos arcos da árvore
+        for (size_t k = 1; k < order.size(); ++k) {
+            int v = order[k], a = pred_[v];
+            pi_[v] = pred_dir_[v] == UP ? pi_[parent_[v]] - cost_[a] : pi_[parent_[v]] + cost_[a];
+        }
+        return true;
+    }
+
+    int64_t reduced(size_t a) const { return cost_[a] + pi_[source_[a]] - pi_[target_[a]]; }
+
+    bool find_entering() {
+        size_t arcs = source_.size();
+        int64_t min = 0;
+        size_t count = block_;
+        size_t a = next_arc_;
+        for (size_t k = 0; k < arcs; ++k, a = a + 1 == arcs ? 0 : a + 1) {
+            int64_t c = state_[a] * reduced(a);
+            if (c < min) {
+                min = c;
+                in_arc_ = a;
+            }
+            if (--count == 0) {
+                if (min < 0)
+                    break;
+                count = block_;
+            }
+        }
+        next_arc_ = a;
+        return min < 0;
+    }
+
+    // Ciclo formado pelo arco que entra: sobe de cada ponta até o ancestral
+    // comum e escolhe o arco de menor fluxo percorrido no sentido contrário
+    bool find_leaving() {
+        int first = source_[in_arc_], second = target_[in_arc_];
+        int u = first, v = second;
+        while (u != v) {
+            if (succ_num_[u] < succ_num_[v])
+                u = parent_[u];
+            else
+                v = parent_[v];
+        }
+        join_ = u;
+
+        delta_ = INF;
+        int result = 0;
+        for (int w = first; w != join_; w = parent_[w])
+            if (pred_dir_[w] == UP && flow_[pred_[w]] < delta_) {
+                delta_ = flow_[pred_[w]];
+                u_out_ = w;
+                result = 1;
+            }
+        for (int w = second; w != join_; w = parent_[w])
+            if (pred_dir_[w] == DOWN && flow_[pred_[w]] <= delta_) {
+                delta_ = flow_[pred_[w]];
+                u_out_ = w;
+                result = 2;
+            }
+        if (result == 0)
+            return false;
+        u_in_ = result == 1 ? first : second;
+        v_in_ = result == 1 ? second : first;
+        return true;
+    }
+
+    void change_flow() {
+        if (delta_ > 0) {
+            flow_[in_arc_] += delta_;
+            for (int u = source_[in_arc_]; u != join_; u = parent_[u])
+                flow_[pred_[u]] -= pred_dir_[u] * delta_;
+            for (int u = target_[in_arc_]; u != join_; u = parent_[u])
+                flow_[pred_[u]] += pred_dir_[u] * delta_;
+        }
+        state_[in_arc_] = TREE;
+        state_[pred_[u_out_]] = LOWER;
+    }
+
+    // Move a subárvore de u_out para debaixo de v_in pelo arco que entra,
+    // invertendo o caminho de u_in a u_out, e acerta thread, descendentes e
+    // últimos descendentes só nos nós afetados
+    void update_tree() {
+        int old_rev_thread = rev_thread_[u_out_];
+        int old_succ_num = succ_num_[u_out_];
+        int old_last_succ = last_succ_[u_out_];
+        int v_out = parent_[u_out_];
+
+        if (u_in_ == u_out_) {
+            parent_[u_in_] = v_in_;
+            pred_[u_in_] = in_arc_;
+            pred_dir_[u_in_] = u_in_ == source_[in_arc_] ? UP : DOWN;
+
+            if (thread_[v_in_] != u_out_) {
+                int after = thread_[old_last_succ];
+                thread_[old_rev_thread] = after;
+                rev_thread_[after] = old_rev_thread;
+                after = thread_[v_in_];
+                thread_[v_in_] = u_out_;
+                rev_thread_[u_out_] = v_in_;
+                thread_[old_last_succ] = after;
+                rev_thread_[after] = old_last_succ;
+            }
+        } else {
+            int thread_continue = old_rev_thread == v_in_ ? thread_[old_last_succ] : thread_[v_in_];
+
+            // Religa os nós do caminho de u_in a u_out, cada um com o
+            // anterior como novo pai, tirando e reinserindo suas subárvores
+            int stem = u_in_, par_stem = v_in_, next_stem;
+            int last = last_succ_[u_in_];
+            int before, after = thread_[last];
+            thread_[v_in_] = u_in_;
+            dirty_revs_.assign(1, v_in_);
+            while (stem != u_out_) {
+                next_stem = parent_[stem];
+                thread_[last] = next_stem;
+                dirty_revs_.push_back(last);
+
+                before = rev_thread_[stem];
+                thread_[before] = after;
+                rev_thread_[after] = before;
+
+                parent_[stem] = par_stem;
+                par_stem = stem;
+                stem = next_stem;
+
+                last = last_succ_[stem] == last_succ_[par_stem] ? rev_thread_[par_stem] : last_succ_[stem];
+                after = thread_[last];
+            }
+            parent_[u_out_] = par_stem;
+            thread_[last] = thread_continue;
+            rev_thread_[thread_continue] = last;
+            last_succ_[u_out_] = last;
+
+            if (old_rev_thread != v_in_) {
+                thread_[old_rev_thread] = after;
+                rev_thread_[after] = old_rev_thread;
+            }
+            for (int u : dirty_revs_)
+                rev_thread_[thread_[u]] = u;
+
+            int succ = 0, tmp_last = last_succ_[u_out_];
+            for (int u = u_out_, p = parent_[u]; u != u_in_; u = p, p = parent_[u]) {
+                pred_[u] = pred_[p];
+                pred_dir_[u] = -pred_dir_[p];
+                succ += succ_num_[u] - succ_num_[p];
+                succ_num_[u] = succ;
+                last_succ_[p] = tmp_last;
+            }
+            pred_[u_in_] = in_arc_;
+            pred_dir_[u_in_] = u_in_ == source_[in_arc_] ? UP : DOWN;
+            succ_num_[u_in_] = old_succ_num;
+        }
+
+        int up_limit_out = last_succ_[join_] == v_in_ ? join_ : -1;
+        int last_succ_out = last_succ_[u_out_];
+        for (int u = v_in_; u != -1 && last_succ_[u] == v_in_; u = parent_[u])
+            last_succ_[u] = last_succ_out;
+
+        if (join_ != old_rev_thread && v_in_ != old_rev_thread) {
+            for (int u = v_out; u != up_limit_out && last_succ_[u] == old_last_succ; u = parent_[u])
+                last_succ_[u] = old_rev_thread;
+        } else if (last_succ_out != old_last_succ) {
+            for (int u = v_out; u != up_limit_out && last_succ_[u] == old_last_succ; u = parent_[u])
+                last_succ_[u] = last_succ_out;
+        }
+
+        for (int u = v_in_; u != join_; u = parent_[u])
+            succ_num_[u] += old_succ_num;
+        for (int u = v_out; u != join_; u = parent_[u])
+            succ_num_[u] -= old_succ_num;
+    }
+
+    // Desloca os potenciais da subárvore de u_in para zerar o custo
+    // reduzido do arco que entrou
+    void update_potential() {
+        int64_t sigma = u_in_ == source_[in_arc_] ? pi_[v_in_] - cost_[in_arc_] - pi_[u_in_]
+                                                  : pi_[v_in_] + cost_[in_arc_] - pi_[u_in_];
+        int end = thread_[last_succ_[u_in_]];
+        for (int u = u_in_; u != end; u = thread_[u])
+            pi_[u] += sigma;
+    }
+};
+
+#endif